@@ -1,10 +1,15 @@
 #pragma once
 // stl
 #include "components/TaskQueue.h"
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <initializer_list>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 
 // vulkan
 #include <vulkan/vulkan.h>
@@ -12,19 +17,34 @@
 
 // vq library
 #include "lib/VQBuffer.h"
+#include "lib/Utils.h"
 #include "lib/VQDevice.h"
 
 // structs
 #include "structs/ImGuiTexture.h"
 #include "structs/SharedEngineStructs.h"
+#include "structs/WindowEvent.h"
 
 // Engine Components
 #include "components/Camera.h"
+#include "components/ClockDomains.h"
 #include "components/DeletionStack.h"
 #include "components/DeltaTimer.h"
+#include "components/EvenOddCalibrator.h"
+#include "components/FrameGraph.h"
+#include "components/FrameJournal.h"
+#include "components/FramePacer.h"
+#include "components/GpuProfiler.h"
 #include "components/InputManager.h"
+#include "components/LoadGenerator.h"
 #include "components/Profiler.h"
+#include "components/SPSCQueue.h"
+#include "components/ScopeStats.h"
 #include "components/TextureManager.h"
+#include "components/ThreadPool.h"
+#include "components/TraceRecorder.h"
+#include "components/VblankClock.h"
+#include "components/VirtualDisplay.h"
 #include "components/imgui_widgets/ImGuiWidget.h"
 
 #include "components/imgui_widgets/ImGuiWidgetEvenOddCalibration.h"
@@ -41,6 +61,10 @@ class Tetrium
   private:
     static const std::vector<const char*> DEFAULT_INSTANCE_EXTENSIONS;
     static const std::vector<const char*> DEFAULT_DEVICE_EXTENSIONS;
+    // window system integration, required by every mode but `kHeadless`
+    static const std::vector<const char*> PRESENTATION_INSTANCE_EXTENSIONS;
+    static const std::vector<const char*> PRESENTATION_DEVICE_EXTENSIONS;
+    static const std::vector<const char*> OPTIONAL_DEVICE_EXTENSIONS; // enabled when supported
 
     static const std::vector<const char*> EVEN_ODD_HARDWARE_INSTANCE_EXTENSIONS;
     static const std::vector<const char*> EVEN_ODD_HARDWARE_DEVICE_EXTENSIONS;
@@ -52,13 +76,42 @@ class Tetrium
     {
         kEvenOddHardwareSync, // use NVIDIA gpu to hardware sync even-odd frames
         kEvenOddSoftwareSync, // use a timer/frame render callback to software sync even-odd frames
-        kDualProjector        // use two projectors and superposition the outputs, not implemented
+        kEvenOddVirtualSync,  // sync even-odd frames to a simulated display, presenting to a
+                              // regular window; for exercising even-odd logic without the rig
+        kDualProjector,       // use two projectors and superposition the outputs, not implemented
+        kHeadless             // render to virtual frame buffers only, no window/display/swapchain;
+                              // for benchmarking
     };
 
     // Initialization options
     struct InitOptions
     {
         TetraMode tetraMode = TetraMode::kEvenOddHardwareSync;
+        // render imgui as a subpass of the main render pass, instead of in its own pass;
+        // saves a store & reload of the attachment. Overridden by `multiview`, whose pass
+        // can't host imgui's subpass.
+        bool mergeImGuiPass = true;
+        // under `kHeadless`: ticks to run before `Run()` returns, and the frame buffer extent
+        uint64_t headlessTicks = 1000;
+        VkExtent2D headlessExtent = {1920, 1080};
+        // tick and present on a dedicated render thread, leaving the thread calling `Run()`
+        // to only handle window events. Not applicable under `kHeadless`.
+        bool renderThread = true;
+        // under `kEvenOddVirtualSync`: refresh rate, jitter & stalls of the simulated display
+        VirtualDisplay::Config virtualDisplay;
+        // hold back the start of each tick so that it submits just before a vblank,
+        // see `FramePacer`. Not applicable under `kHeadless`.
+        bool framePacing = false;
+        // run `LoadGenerator`'s default soak test from the first frame, this many seconds per
+        // load level; 0 to not
+        double soakSecondsPerLevel = 0;
+        // pin the thread that samples parity & presents to a core, and schedule it SCHED_FIFO;
+        // see `_presentThreadCtx`. -1 picks the first isolated core, else the last core
+        bool realtimePresentThread = false;
+        int presentThreadCore = -1;
+        // render both color spaces in a single multiview pass where supported, see
+        // `_multiviewCtx`; parity prediction & parallel recording sit out while it's on
+        bool multiview = false;
     };
 
     // Engine-wide static UBO that gets updated every Tick()
@@ -91,9 +144,11 @@ class Tetrium
         std::vector<VkImageView> imageView;
         std::vector<VkFramebuffer> frameBuffer;
         size_t numImages;
-        VkImage depthImage;
-        VkDeviceMemory depthImageMemory;
-        VkImageView depthImageView;
+        // depth buffers, one per swapchain image so that frames in flight
+        // never share a depth attachment
+        std::vector<VkImage> depthImage;
+        std::vector<VkDeviceMemory> depthImageMemory;
+        std::vector<VkImageView> depthImageView;
         VkSurfaceKHR surface;
     };
 
@@ -115,7 +170,6 @@ class Tetrium
         VkSemaphore semaImageCopyFinished;
         VkSemaphore semaVsync;
         VkFence fenceInFlight;
-        VkFence fenceRenderFinished;
     };
 
     // render context for the dual-pass, virtual frame buffer rendering architecture.
@@ -126,10 +180,30 @@ class Tetrium
     // gets copied to the actual frame buffer, stored in `SwapChainContext::frameBuffer`
     struct VirtualFrameBuffer
     {
+        static inline const uint64_t NEVER_RENDERED = UINT64_MAX;
         std::vector<VkFramebuffer> frameBuffer;
         std::vector<VkImage> image;
         std::vector<VkImageView> imageView;
         std::vector<VkDeviceMemory> imageMemory; // memory to hold virtual swap chain
+        std::vector<uint64_t> renderTick; // tick # at which each image was last rendered into,
+                                          // `NEVER_RENDERED` if its content is undefined
+        // array layer of `image` holding this color space. Under multiview, `image` is owned
+        // by the `MultiviewFrameBuffer` and `imageMemory` is VK_NULL_HANDLE.
+        uint32_t layer = 0;
+    };
+
+    // 2-layer image arrays that both color spaces render into in a single multiview pass;
+    // layer 0 holds RGB and layer 1 holds OCV.
+    // Each color space's `VirtualFrameBuffer` views its own layer.
+    struct MultiviewFrameBuffer
+    {
+        std::vector<VkFramebuffer> frameBuffer;
+        std::vector<VkImage> image;
+        std::vector<VkImageView> imageView; // views both layers
+        std::vector<VkDeviceMemory> imageMemory;
+        std::vector<VkImage> depthImage;
+        std::vector<VkImageView> depthImageView;
+        std::vector<VkDeviceMemory> depthImageMemory;
     };
 
     // Render context for RGV/OCV color space
@@ -138,13 +212,37 @@ class Tetrium
     {
         VkRenderPass renderPass;
         VirtualFrameBuffer virtualFrameBuffer;
+        // pre-recorded commands that copy each virtual frame buffer image
+        // onto the swapchain image of the same index
+        std::vector<VkCommandBuffer> swapchainCopyCommandBuffers;
+    };
+
+    // Secondary command buffers of a single color space, for a single frame in flight.
+    // Scene and imgui are recorded on different threads at the same time,
+    // so each has its own command pool.
+    struct SecondaryCommandContext
+    {
+        VkCommandPool scenePool = VK_NULL_HANDLE;
+        VkCommandBuffer sceneCB = VK_NULL_HANDLE; // main render pass, recorded on a worker
+        VkCommandPool imguiPool = VK_NULL_HANDLE;
+        VkCommandBuffer imguiCB = VK_NULL_HANDLE; // imgui render pass
+    };
+
+    // frame graph handles of the images a frame renders into
+    struct FrameGraphTargets
+    {
+        FrameGraph::ResourceId color[ColorSpace::ColorSpaceSize]; // virtual frame buffers
+        FrameGraph::ResourceId depth; // shared by all scene passes
     };
 
     // Context for imgui rendering
     // imgui stays as a struct due to its backend's coupling with Vulkan backend.
     struct ImGuiRenderContexts
     {
-        VkRenderPass renderPass;
+        // imgui is subpass 1 of each color space's main render pass,
+        // `renderPass` and `frameBuffers` are unused
+        bool mergedIntoMainPass = false;
+        VkRenderPass renderPass = VK_NULL_HANDLE;
         VkDescriptorPool descriptorPool;
         std::unordered_map<std::string, ImGuiTexture> textures;
         std::vector<VkFramebuffer> frameBuffers[ColorSpace::ColorSpaceSize];
@@ -152,12 +250,48 @@ class Tetrium
         ImPlotContext* ctxImPlot[ColorSpace::ColorSpaceSize] = {};
     };
 
+    // the display's timing as used for a tick's parity decision; captured once per tick by
+    // `captureTimingSnapshot()`, everything else reads it instead of querying the display again
+    struct TimingSnapshot
+    {
+        uint64_t tick = 0;
+        uint64_t surfaceCounter = 0;
+        ColorSpace colorSpace = RGB; // the counter's parity, after `_flipEvenOdd`
+        uint64_t refreshPeriodNanoSeconds = 0;
+        // last time the display flipped, from present timing or the vblank clock
+        std::optional<std::chrono::steady_clock::time_point> lastPresentTime;
+        std::chrono::steady_clock::time_point captureTime;
+    };
+
+    // aggregated cost of all profiler entries of the same name, over a headless run
+    struct ProfilerSummaryEntry
+    {
+        double totalMilliseconds = 0;
+        double maxMilliseconds = 0;
+        uint64_t count = 0;
+    };
+
     /* ---------- Windowing ---------- */;
     std::pair<GLFWmonitor*, GLFWvidmode> cliMonitorModeSelection();
     GLFWwindow* initGLFW(bool promptUserForFullScreenWindow);
     [[deprecated("Use selectDisplayXlib")]] void selectDisplayDRM(DisplayContext& ctx);
     void selectDisplayXlib(DisplayContext& ctx);
     void initExclusiveDisplay(DisplayContext& ctx);
+    // sizes of `_window`, safe to call from any thread; the swapchain extent when headless
+    void getWindowSize(int& width, int& height);
+    void getFramebufferSize(int& width, int& height);
+    void publishWindowSize(); // main thread only, refresh the sizes seen by the render thread
+    // run TASK on the main thread, which is the only one allowed to call most of glfw;
+    // runs TASK right away without a render thread
+    void runOnMainThread(std::function<void()> task);
+    void runMainThreadTasks(); // main thread only
+
+    /* ---------- Render Thread ---------- */
+    void renderThreadLoop();
+    // apply `_presentThreadCtx`'s setting if it changed & count the last frame's context
+    // switches; from the thread that ticks
+    void updatePresentThreadScheduling();
+    void dispatchWindowEvents(); // replay window events polled on the main thread
 
     /* ---------- Initialization Subroutines ---------- */
     void initVulkan();
@@ -165,7 +299,13 @@ class Tetrium
     VkInstance createInstance();
     void createDevice();
     VkSurfaceKHR createGlfwWindowSurface(GLFWwindow* window);
-    vk::RenderPass createRenderPass(const VkFormat imageFormat); // create main render pass
+    // create main render pass; a non-zero VIEWMASK creates its multiview variant,
+    // IMGUISUBPASS appends a subpass for imgui
+    vk::RenderPass createRenderPass(
+        const VkFormat imageFormat,
+        uint32_t viewMask = 0,
+        bool imguiSubpass = false
+    );
     void createSynchronizationObjects(std::array<SyncPrimitives, NUM_FRAME_IN_FLIGHT>& primitives);
     void createFunnyObjects();
 
@@ -187,18 +327,31 @@ class Tetrium
     void recreateSwapChain(SwapChainContext& ctx);
     void cleanupSwapChain(SwapChainContext& ctx);
     void createSwapChain(Tetrium::SwapChainContext& ctx, const VkSurfaceKHR surface);
+    // a swapchain context without swapchain, whose images are only rendered into
+    void createHeadlessSwapChain(Tetrium::SwapChainContext& ctx, VkExtent2D extent);
     void createImageViews(SwapChainContext& ctx);
     void createDepthBuffer(SwapChainContext& ctx);
     void createSwapchainFrameBuffers(SwapChainContext& ctx, VkRenderPass rgbOrCnyPass);
 
     /* ---------- FrameBuffers ---------- */
     void recreateVirtualFrameBuffers();
+    // create VFB's images, or views into MULTIVIEW's layer LAYER if given
     void createVirtualFrameBuffer(
         VkRenderPass renderPass,
         const SwapChainContext& swapChain,
-        VirtualFrameBuffer& vfb
+        VirtualFrameBuffer& vfb,
+        const MultiviewFrameBuffer* multiview = nullptr,
+        uint32_t layer = 0
     );
     void clearVirtualFrameBuffer(VirtualFrameBuffer& vfb);
+    void createMultiviewFrameBuffer(
+        VkRenderPass renderPass,
+        const SwapChainContext& swapChain,
+        MultiviewFrameBuffer& mfb
+    );
+    void clearMultiviewFrameBuffer(MultiviewFrameBuffer& mfb);
+    void recordSwapchainCopyCommandBuffers(); // (re)record `swapchainCopyCommandBuffers`
+    void freeSwapchainCopyCommandBuffers();
 
     /* ---------- Debug Utilities ---------- */
     bool checkValidationLayerSupport();
@@ -222,16 +375,96 @@ class Tetrium
     void drawImGui(ColorSpace colorSpace);
     void flushEngineUBOStatic(uint8_t frame);
     void getMainProjectionMatrix(glm::mat4& projectionMatrix);
+    // record COLORSPACE's scene draw calls into `ctx->graphics.CB`,
+    // which must be inside the color space's main render pass
+    void recordSceneCommands(const TickContext* ctx, ColorSpace colorSpace);
+    bool checkMultiviewSupport(); // whether the device and shaders support multiview rendering
+
+    /* ---------- Frame Graph ---------- */
+    // layout the virtual frame buffers are left in once a frame's passes are done
+    VkImageLayout getVirtualFrameBufferFinalLayout() const;
+    FrameGraphTargets importFrameGraphTargets(FrameGraph& graph, uint32_t swapchainImageIndex);
+    // declare both color spaces' scene and imgui passes, returns each color space's scene pass
+    std::array<FrameGraph::PassId, ColorSpace::ColorSpaceSize> addColorSpacePasses(
+        const TickContext* ctx,
+        FrameGraph& graph,
+        const FrameGraphTargets& targets,
+        uint32_t swapchainImageIndex
+    );
+    // same as `addColorSpacePasses()`, with a single multiview scene pass for both color spaces
+    std::array<FrameGraph::PassId, ColorSpace::ColorSpaceSize> addMultiviewPasses(
+        const TickContext* ctx,
+        FrameGraph& graph,
+        const FrameGraphTargets& targets,
+        uint32_t swapchainImageIndex
+    );
+
+    /* ---------- Parallel Recording ---------- */
+    void initParallelRecording();
+    void cleanupParallelRecording();
+    // record the scene and imgui passes of COLORSPACES into secondary command buffers
+    // concurrently, for the frame graph's passes to execute
+    void recordSecondaryCommandBuffers(
+        const TickContext* ctx,
+        const std::vector<ColorSpace>& colorSpaces,
+        uint32_t swapchainImageIndex
+    );
+
+    /* ---------- GPU Timing ---------- */
+    void initGPUTiming();
+    void cleanupGPUTiming();
+    // read back FRAME's GPU scopes into the profiler, FRAME's fence must have signaled
+    void collectGPUTiming(uint8_t frame);
+
+    /* ---------- Static-Frame Cache ---------- */
+    void markFrameDirty(); // content on screen changed, cached virtual frame buffers are stale
+    void updateFrameDirtyState(); // poll camera, entities and input for changes
+    bool isCachedFrameValid(uint32_t swapchainImageIndex); // both color spaces up-to-date
+
+    /* ---------- Headless ---------- */
+    void runHeadless(); // run `InitOptions::headlessTicks` ticks, then print a profiler summary
+    void accumulateProfilerSummary(const std::vector<Profiler::Entry>& profile);
+    void printProfilerSummary();
 
     /* ---------- Even-Odd frame ---------- */
     void initEvenOdd(); // initialize resources for even-odd rendering
     void cleanupEvenOdd();
     void checkHardwareEvenOddFrameSupport(); // checks hw support for even-odd rendering
     void setupHardwareEvenOddFrame();        // set up resources for even-odd frame
+    void startVblankThread();
+    void stopVblankThread();
+    void vblankThreadLoop(); // publish every vblank onto `_vblankCtx.clock`
+    void virtualVblankThreadLoop(); // `vblankThreadLoop()`, for `_virtualDisplay`'s vblanks
+    // if the next vblank is due within `_vblankCtx.submitGuardNanoSeconds`, block until it passes
+    void waitOutImminentVblank();
     void checkSoftwareEvenOddFrameSupport(); // checks sw support for even-odd rendering
     void setupSoftwareEvenOddFrame();        // set up resources for software-based even-odd frame
+    // linux software even-odd: the thread waiting on present completions,
+    // stopped around swapchain recreation
+    void startPresentWaiter();
+    void stopPresentWaiter();
+    void presentWaiterLoop();
+    uint64_t queuePresentId(); // tag a new present, returns its id
+    // for acquire & present, host access to the swapchain is shared with the present waiter
+    std::unique_lock<std::mutex> lockSwapchain();
     uint64_t getSurfaceCounterValue(); // get the number of frames requested so far from the display
-    bool isEvenFrame();
+    // line the vblank thread's count up with COUNTER, the swapchain's, read after NUMVBLANKS
+    void alignVblankCounter(uint64_t counter, uint64_t numVblanks);
+    bool isEvenFrame(); // parity of `_timingSnapshot`'s counter, before `_flipEvenOdd`
+    // query the display once for the tick's parity decision, into `_timingSnapshot`
+    void captureTimingSnapshot();
+    uint64_t getRefreshPeriodNanoSeconds();
+    // calibrate `_vblankCtx.submitGuardNanoSeconds` against parity misses, see
+    // `_evenOddCalibrationCtx`; results persist per display mode
+    void startEvenOddCalibration();
+    void cancelEvenOddCalibration();
+    void updateEvenOddCalibration(); // once per tick, after the frame got journaled
+    std::string getEvenOddCalibrationKey(); // of the current display mode
+    // record a surface counter sample, used to bound when the last vblank happened
+    void observeSurfaceCounter(uint64_t counter, std::chrono::steady_clock::time_point time);
+    // predict the color space the current frame will present,
+    // `std::nullopt` if a vblank may happen before the parity gets sampled.
+    std::optional<ColorSpace> predictPresentedColorSpace();
 
     /* ---------- ImGui ---------- */
     void initImGuiRenderContext(Tetrium::ImGuiRenderContexts& ctx);
@@ -244,11 +477,16 @@ class Tetrium
         vk::Extent2D extent,
         int swapChainImageIndex
     );
+    // record COLORSPACE's imgui draw data into CB, which must be inside the imgui render pass
+    void recordImGuiDrawData(ColorSpace colorSpace, vk::CommandBuffer cb);
     const ImGuiTexture& getOrLoadImGuiTexture(
         Tetrium::ImGuiRenderContexts& ctx,
         const std::string& texture
     );
     void clearImGuiDrawData();
+    // `ImGui_ImplGlfw_NewFrame()`, or its equivalent where glfw can't be called
+    void newImGuiPlatformFrame();
+    uint64_t getNumImGuiInputEvents(); // number of window inputs forwarded to imgui so far
 
     /* ---------- Top-level data ---------- */
     VkInstance _instance;
@@ -259,7 +497,7 @@ class Tetrium
     ImGuiRenderContexts _imguiCtx;
 
     /* ---------- Prensentation ---------- */
-    GLFWwindow* _window;
+    GLFWwindow* _window = nullptr; // null under `kHeadless`
     DisplayContext _mainProjectorDisplay;
 
     /* ---------- Render Contexts ---------- */
@@ -296,7 +534,7 @@ class Tetrium
     std::array<VQBuffer, NUM_FRAME_IN_FLIGHT> _engineUBOStatic;
 
     float _FOV = 90;
-    double _timeSinceStartSeconds; // seconds in time since engine start, regardless of pause
+    double _timeSinceStartSeconds = 0; // seconds in time since engine start, regardless of pause
     unsigned long int
         _timeSinceStartNanoSeconds;  // nanoseconds in time since engine start, regardless of pause
     unsigned long int _numTicks = 0; // how many ticks has happened so far
@@ -310,6 +548,30 @@ class Tetrium
         PFN_vkGetSwapchainCounterEXT vkGetSwapchainCounterEXT = nullptr;
     } _hardWareEvenOddCtx;
 
+    // hardware even-odd sync: a dedicated thread waits on a display event for every vblank and
+    // timestamps it, so that the render loop knows when vblanks happen instead of guessing.
+    // Under virtual even-odd sync, it sleeps until each of `_virtualDisplay`'s vblanks instead;
+    // under linux software sync, the present waiter publishes present completions onto `clock`.
+    // The thread never touches the swapchain, which the render thread presents to & recreates
+    struct
+    {
+        PFN_vkRegisterDisplayEventEXT vkRegisterDisplayEventEXT = nullptr;
+        std::thread thread;
+        std::atomic<bool> stop = false;
+        VblankClock clock;
+        std::atomic<uint64_t> numVblanks = 0; // display events seen, hardware even-odd sync
+        // from `numVblanks` onto the swapchain's counter, see `alignVblankCounter()`
+        std::atomic<uint64_t> counterOffset = 0;
+        bool realtime = false; // the thread got a real-time scheduling class
+        std::atomic<uint64_t> numEvents = 0;
+        std::atomic<uint64_t> numTimeouts = 0; // waits that saw no vblank
+        // hold back the parity sample & copy submission while a vblank is closer than this,
+        // then submit right after it
+        bool pacedSubmission = true;
+        int64_t submitGuardNanoSeconds = 2'000'000;
+        uint64_t numPacedWaits = 0;
+    } _vblankCtx;
+
     // context for software-based even-odd frame sync
     struct
     {
@@ -326,14 +588,180 @@ class Tetrium
                                            // strictly increase over time
         int vsyncFrameOffset = 0;
         uint64_t numFramesPresented = 0; // total number of frames that have been presented so far
+        // MoltenVK present timing, read into preallocated storage
+        PFN_vkGetPastPresentationTimingGOOGLE vkGetPastPresentationTimingGOOGLE = nullptr;
+        std::vector<VkPastPresentationTimingGOOGLE> pastPresentationTimings;
     } _softwareEvenOddCtx;
 
+    // software even-odd sync on linux: every present is tagged with a present id, a helper thread
+    // sleeps in `vkWaitForPresentKHR()` on each of them and counts the vblanks in between
+    // confirmed completions, which stands in for the hardware vblank counter.
+    // The swapchain must be externally synchronized, so the waiter holds `swapchainMutex` for at
+    // most `SWAPCHAIN_HOLD_NANOSECONDS` at a time, and backs off while acquire or present wait.
+    static constexpr uint64_t SWAPCHAIN_HOLD_NANOSECONDS = 1'000'000;
+    struct
+    {
+        PFN_vkWaitForPresentKHR vkWaitForPresentKHR = nullptr;
+        std::thread thread;
+        std::mutex swapchainMutex; // held around every call taking `_swapChain.chain`
+        std::atomic<uint32_t> numSwapchainWaiters = 0; // blocked in `lockSwapchain()`
+        std::mutex mutex; // guards `submittedPresentId` & `stop`
+        std::condition_variable cvSubmitted; // signaled on new present / stop
+        uint64_t submittedPresentId = 0; // id of the latest queued present
+        bool stop = false;
+        std::atomic<uint64_t> numVblanks = 0; // the surface counter
+        std::atomic<uint64_t> refreshPeriodNanoSeconds = 0; // refined from completion intervals
+        std::atomic<uint64_t> numPresentsCompleted = 0;
+        std::atomic<uint64_t> numRepeatedVblanks = 0; // vblanks that showed the previous frame
+    } _presentWaitCtx;
+
+    TimingSnapshot _timingSnapshot; // of the latest copy submission
+
     struct
     {
         uint32_t numDroppedFrames = 0;
         bool currShouldBeEven = true;
     } _evenOddDebugCtx;
 
+    // the frames behind `_evenOddDebugCtx.numDroppedFrames`, snapshotted around each drop
+    FrameJournal _frameJournal;
+    // tail latency of every profiler scope, against the refresh period
+    ScopeStats _scopeStats;
+
+    // auto-calibration of the submit guard, run a frame at a time from `Tick()`
+    struct
+    {
+        EvenOddCalibrator calibrator;
+        int64_t guardBeforeNanoSeconds = 0; // restored on cancel
+        bool loaded = false; // looked up the saved calibration for the display mode
+        std::string key;     // display mode the current guard got calibrated for
+        std::optional<EvenOddCalibrator::Result> result; // applied, loaded or calibrated
+    } _evenOddCalibrationCtx;
+
+    // synthetic CPU, memory & GPU load, and the soak tests stepping through it
+    LoadGenerator _loadGenerator;
+
+    // profiler entries of every tick streamed to a trace file, toggled from the perf widget
+    TraceRecorder _traceRecorder;
+
+    // the display under `kEvenOddVirtualSync`, standing in for the surface counter;
+    // the vblank thread publishes its vblanks, presents report where they land on it
+    VirtualDisplay _virtualDisplay;
+
+    // just-in-time tick starts, phase-locked to the vblanks seen by `observeSurfaceCounter()`
+    FramePacer _framePacer;
+
+    // context for parity-predictive rendering, where only the color space
+    // predicted to be presented gets rendered
+    struct
+    {
+        bool enabled = false;
+        // extra time required between the prediction and the next vblank,
+        // on top of the measured prediction-to-sample latency
+        int safetyMarginNanoSeconds = 500000;
+        uint64_t lastObservedCounter = 0;
+        std::chrono::steady_clock::time_point lastObservedTime; // time of the latest sample
+        std::chrono::steady_clock::time_point vblankLowerBound; // last vblank happened after this
+        double predictionToSampleNanoSeconds = 0; // moving average of time from the prediction
+                                                  // to the parity sample in `drawFrame()`
+        bool lastFramePredicted = false;
+        uint64_t numPredictions = 0; // frames rendered with a single color space
+        uint64_t numHits = 0;        // predictions that matched the sampled parity
+        uint64_t numDualRenders = 0; // frames that fell back to rendering both color spaces
+    } _parityPredictionCtx;
+
+    // static-frame cache: when nothing on screen changes, rendering is skipped
+    // and the cached virtual frame buffers get copied to the swapchain
+    struct
+    {
+        bool enabled = true;
+        double inputSettleSeconds = 1; // keep rendering for a while after an input,
+                                       // for imgui's animations
+        bool dirty = true;          // whether the current tick has any changes
+        uint64_t lastDirtyTick = 0; // tick # of the latest change
+        uint64_t lastNumInputEvents = 0;
+        double lastInputTime = 0; // `_timeSinceStartSeconds` of the last input
+        glm::mat4 lastViewMatrix = glm::mat4(0.f);
+        float lastFOV = 0;
+        bool liveWidgetShown = false; // a widget with per-tick content (plots, counters) is shown
+        bool lastFrameCached = false;
+        uint64_t numCachedFrames = 0;
+    } _staticFrameCtx;
+
+    // GPU scopes around the render submission, its frame graph passes and the swapchain copy
+    GpuProfiler _gpuProfiler;
+    std::chrono::steady_clock::time_point _lastClockCalibration;
+
+    // converts GPU & present timestamps to the steady clock, recalibrated by `collectGPUTiming()`
+    ClockDomains _clockDomains;
+
+    // headless benchmarking, see `TetraMode::kHeadless`
+    struct
+    {
+        uint64_t numTicks = 0; // ticks to run
+        VkExtent2D extent = {};
+        std::map<std::string, ProfilerSummaryEntry> summary; // profiler entries by name
+    } _headlessCtx;
+
+    // dedicated render thread: the main thread only polls window events and runs
+    // `runOnMainThread()` tasks, the render thread ticks and owns all Vulkan submissions
+    struct
+    {
+        bool enabled = false;
+        std::thread thread;
+        std::atomic<bool> stop = false;
+        SPSCQueue<WindowEvent, 1024> windowEvents;            // main -> render
+        SPSCQueue<std::function<void()>, 64> mainThreadTasks; // render -> main
+        // [width, height] packed into the high & low 32 bits
+        std::atomic<uint64_t> windowSize = 0;
+        std::atomic<uint64_t> framebufferSize = 0;
+        std::atomic<uint64_t> numDroppedWindowEvents = 0; // events lost to a full queue
+    } _renderThreadCtx;
+
+    // opt-in real-time scheduling of the thread that ticks, i.e. samples parity & presents,
+    // so that it doesn't get preempted right before `vkQueuePresentKHR()`: pinned to an
+    // isolated core and SCHED_FIFO, or a raised nice value where real-time isn't permitted.
+    // Linux only; applied by the thread itself, see `updatePresentThreadScheduling()`
+    struct
+    {
+        bool requested = false;
+        int requestedCore = -1; // -1: the first isolated core, else the last core
+        bool applied = false;   // `requested` as last applied
+        int core = -1;          // pinned to, -1 if not pinned
+        bool realtime = false;
+        bool niced = false; // fell back to a raised nice value
+        std::optional<Utils::Thread::Scheduling> savedScheduling; // restored once not requested
+        std::unique_ptr<Utils::Thread::ContextSwitchCounter> switchCounter; // of the thread
+        std::optional<Utils::Thread::ContextSwitches> lastSwitches;
+        uint32_t lastFrameInvoluntarySwitches = 0;
+        double involuntarySwitchesPerFrame = 0; // moving average
+        uint64_t numInvoluntarySwitches = 0;
+        uint64_t numFramesSwitchedOut = 0; // involuntarily, at least once
+        uint64_t numFrames = 0;
+        std::array<float, 256> history = {}; // involuntary switches per frame, a ring
+    } _presentThreadCtx;
+
+    // multiview rendering: both color spaces get rendered in one pass,
+    // with geometry processed once. Opt-in through `InitOptions::multiview`; falls back to one
+    // pass per color space when not requested or unsupported.
+    struct
+    {
+        bool requested = false;
+        bool supported = false; // requested, and device and shaders support multiview
+        bool enabled = false;
+        VkRenderPass renderPass = VK_NULL_HANDLE;
+        MultiviewFrameBuffer frameBuffer;
+    } _multiviewCtx;
+
+    // parallel command recording: each color space gets recorded into its own
+    // secondary command buffers on a worker thread
+    struct
+    {
+        bool enabled = true;
+        std::array<SecondaryCommandContext, ColorSpace::ColorSpaceSize>
+            secondaryCommands[NUM_FRAME_IN_FLIGHT];
+    } _parallelRecordingCtx;
+
     /* ---------- Engine Components ---------- */
     DeletionStack _deletionStack;
     TextureManager _textureManager;
@@ -342,7 +770,9 @@ class Tetrium
     InputManager _inputManager;
     Profiler _profiler;
     TaskQueue _taskQueue;
-    std::unique_ptr<std::vector<Profiler::Entry>> _lastProfilerData = _profiler.NewProfile();
+    ThreadPool _threadPool; // workers for parallel command recording
+    FrameGraph _frameGraph; // the render submission's passes, rebuilt every frame
+    const std::vector<Profiler::Entry>* _lastProfilerData = &_profiler.NewProfile();
 
     // ImGui widgets
     friend class ImGuiWidgetDeviceInfo;
@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <fcntl.h>
+#include <filesystem>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -20,6 +21,8 @@
 #include "components/VulkanUtils.h" // FIXME: this shouldn't be here
 #include "imgui.h"
 
+#include "lib/Utils.h"
+
 // Molten VK Config
 #if __APPLE__
 #include "MoltenVKConfig.h"
@@ -66,16 +69,15 @@ void Tetrium::keyCallback(GLFWwindow* window, int key, int scancode, int action,
     // toggle cursor lock
     if (key == GLFW_KEY_TAB && action == GLFW_PRESS) {
         _windowFocused = !_windowFocused;
-        if (_windowFocused) {
-            glfwSetInputMode(_window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-        } else {
-            glfwSetInputMode(_window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-        }
+        int cursorMode = _windowFocused ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL;
+        runOnMainThread([this, cursorMode]() {
+            glfwSetInputMode(_window, GLFW_CURSOR, cursorMode);
+        });
         // only activate input on cursor lock
         _inputManager.SetActive(_windowFocused);
     }
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
-        glfwSetWindowShouldClose(_window, GLFW_TRUE);
+        runOnMainThread([this]() { glfwSetWindowShouldClose(_window, GLFW_TRUE); });
     }
 }
 
@@ -126,17 +128,43 @@ void Tetrium::Init(const Tetrium::InitOptions& options)
 {
     // populate static config fields
     _tetraMode = options.tetraMode;
+    _imguiCtx.mergedIntoMainPass = options.mergeImGuiPass;
+    _renderThreadCtx.enabled = options.renderThread && _tetraMode != TetraMode::kHeadless;
     if (_tetraMode == TetraMode::kDualProjector) {
         NEEDS_IMPLEMENTATION();
     }
+    if (_tetraMode == TetraMode::kEvenOddVirtualSync) {
+        _virtualDisplay.Init(options.virtualDisplay); // vblanks start ticking from here
+    }
+    _framePacer.Init({.enabled = options.framePacing && _tetraMode != TetraMode::kHeadless});
+    _frameJournal.Init(256, 16); // ~4s of history at 60Hz, 16 frames leading up to each drop
+    _scopeStats.Init();
+    // a worker per core at most, each streaming 32MB to outsize the caches
+    _loadGenerator.Init(std::max(std::thread::hardware_concurrency(), 1u), 32 << 20);
+    SCHEDULE_DELETE(_loadGenerator.Cleanup();)
+    SCHEDULE_DELETE(_traceRecorder.Stop();)
+    _presentThreadCtx.requested = options.realtimePresentThread;
+    _multiviewCtx.requested = options.multiview;
+    _presentThreadCtx.requestedCore = options.presentThreadCore;
+    if (options.soakSecondsPerLevel > 0) {
+        _loadGenerator.StartSoak(_loadGenerator.GetDefaultSoakScript(options.soakSecondsPerLevel));
+    }
 #if __APPLE__
     MoltenVKConfig::Setup();
 #endif // __APPLE__
-    _window = initGLFW(options.tetraMode == TetraMode::kEvenOddSoftwareSync);
-    glfwSetWindowUserPointer(_window, this);
-    SCHEDULE_DELETE(glfwDestroyWindow(_window); glfwTerminate();)
+    if (_tetraMode == TetraMode::kHeadless) {
+        _headlessCtx.numTicks = options.headlessTicks;
+        _headlessCtx.extent = options.headlessExtent;
+        // every tick should render, the cache would skip the work to be measured
+        _staticFrameCtx.enabled = false;
+    } else {
+        _window = initGLFW(options.tetraMode == TetraMode::kEvenOddSoftwareSync);
+        glfwSetWindowUserPointer(_window, this);
+        SCHEDULE_DELETE(glfwDestroyWindow(_window); glfwTerminate();)
+        publishWindowSize();
+    }
 
-    { // Input Handling
+    if (_window) { // Input Handling
         auto keyCallback = [](GLFWwindow* window, int key, int scancode, int action, int mods) {
             Tetrium* pThis = reinterpret_cast<Tetrium*>(glfwGetWindowUserPointer(window));
             pThis->keyCallback(window, key, scancode, action, mods);
@@ -172,8 +200,12 @@ void Tetrium::Init(const Tetrium::InitOptions& options)
     }
 
     if (_tetraMode == TetraMode::kEvenOddHardwareSync
-        || _tetraMode == TetraMode::kEvenOddSoftwareSync) {
+        || _tetraMode == TetraMode::kEvenOddSoftwareSync
+        || _tetraMode == TetraMode::kEvenOddVirtualSync) {
         initEvenOdd();
+        _deletionStack.push([this]() { cleanupEvenOdd(); });
+    } else if (_tetraMode == TetraMode::kHeadless) {
+        // frame parity comes from a synthetic counter, see `getSurfaceCounterValue()`
     } else {
         NEEDS_IMPLEMENTATION()
     }
@@ -186,6 +218,7 @@ void Tetrium::Init(const Tetrium::InitOptions& options)
         initCtx.swapChainImageFormat = _swapChain.imageFormat;
         initCtx.renderPasses[RGB] = _renderContexts[RGB].renderPass;
         initCtx.renderPasses[OCV] = _renderContexts[OCV].renderPass;
+        initCtx.multiviewRenderPass = _multiviewCtx.renderPass;
         for (int i = 0; i < _engineUBOStatic.size(); i++) {
             initCtx.engineUBOStaticDescriptorBufferInfo[i].range = sizeof(EngineUBOStatic);
             initCtx.engineUBOStaticDescriptorBufferInfo[i].buffer = _engineUBOStatic[i].buffer;
@@ -229,29 +262,75 @@ void Tetrium::initVulkan()
         mainWindowSurface = _mainProjectorDisplay.surface;
         break;
     case TetraMode::kEvenOddSoftwareSync:
+    case TetraMode::kEvenOddVirtualSync: // a regular window, parity comes from the simulation
         mainWindowSurface = createGlfwWindowSurface(_window);
         break;
+    case TetraMode::kHeadless: // nothing to present to
+        break;
     default:
         NEEDS_IMPLEMENTATION();
     };
 
-    ASSERT(mainWindowSurface);
+    ASSERT(mainWindowSurface || _tetraMode == TetraMode::kHeadless);
 
     this->_device->InitQueueFamilyIndices(mainWindowSurface);
-    this->_device->CreateLogicalDeviceAndQueue(getRequiredDeviceExtensions());
+    this->_device->CreateLogicalDeviceAndQueue(
+        getRequiredDeviceExtensions(), OPTIONAL_DEVICE_EXTENSIONS
+    );
     this->_device->CreateGraphicsCommandPool();
     this->_device->CreateGraphicsCommandBuffer(NUM_FRAME_IN_FLIGHT);
+    _frameGraph.Init(
+        _device->logicalDevice,
+        _device->IsExtensionEnabled(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)
+    );
 
-    createSwapChain(_swapChain, mainWindowSurface);
+    if (_tetraMode == TetraMode::kHeadless) {
+        createHeadlessSwapChain(_swapChain, _headlessCtx.extent);
+    } else {
+        createSwapChain(_swapChain, mainWindowSurface);
+    }
     createImageViews(_swapChain);
     ASSERT(_swapChain.imageFormat);
     createDepthBuffer(_swapChain);
 
+    _multiviewCtx.supported = _multiviewCtx.requested && checkMultiviewSupport();
+    _multiviewCtx.enabled = _multiviewCtx.supported;
+    if (_multiviewCtx.enabled) {
+        INFO("Multiview: color spaces are rendered in a single pass, parity prediction and "
+             "parallel recording are off.");
+    } else {
+        INFO("Color spaces are rendered in a pass each.");
+    }
+    if (_multiviewCtx.supported) { // one view per color space
+        _multiviewCtx.renderPass = createRenderPass(_swapChain.imageFormat, 0b11);
+        createMultiviewFrameBuffer(_multiviewCtx.renderPass, _swapChain, _multiviewCtx.frameBuffer);
+        _deletionStack.push([this] {
+            vkDestroyRenderPass(_device->logicalDevice, _multiviewCtx.renderPass, NULL);
+            clearMultiviewFrameBuffer(_multiviewCtx.frameBuffer);
+        });
+    }
+    const MultiviewFrameBuffer* multiview
+        = _multiviewCtx.supported ? &_multiviewCtx.frameBuffer : nullptr;
+    // imgui's pipeline is built for one render pass & subpass, and a multiview render pass can't
+    // host imgui's per-color space subpass; with multiview requested, imgui keeps its own pass
+    // under both paths so that multiview stays toggleable at runtime.
+    if (_imguiCtx.mergedIntoMainPass && _multiviewCtx.supported) {
+        INFO("ImGui: separate render pass, multiview was requested.");
+        _imguiCtx.mergedIntoMainPass = false;
+    } else if (_imguiCtx.mergedIntoMainPass) {
+        INFO("ImGui: subpass of the main render pass.");
+    } else {
+        INFO("ImGui: separate render pass.");
+    }
+
     // create context for rgb and ocv rendering
     for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
         RenderContext* ctx = &_renderContexts[cs];
-        ctx->renderPass = createRenderPass(_swapChain.imageFormat);
-        createVirtualFrameBuffer(ctx->renderPass, _swapChain, ctx->virtualFrameBuffer);
+        ctx->renderPass
+            = createRenderPass(_swapChain.imageFormat, 0, _imguiCtx.mergedIntoMainPass);
+        createVirtualFrameBuffer(
+            ctx->renderPass, _swapChain, ctx->virtualFrameBuffer, multiview, cs
+        );
         _deletionStack.push([this, ctx] {
             vkDestroyRenderPass(_device->logicalDevice, ctx->renderPass, NULL);
             clearVirtualFrameBuffer(ctx->virtualFrameBuffer);
@@ -263,8 +342,17 @@ void Tetrium::initVulkan()
 
     _deletionStack.push([this] { cleanupSwapChain(_swapChain); });
 
+    recordSwapchainCopyCommandBuffers();
+    _deletionStack.push([this] { freeSwapchainCopyCommandBuffers(); });
+
     this->createSynchronizationObjects(_syncProjector);
 
+    initParallelRecording();
+    _deletionStack.push([this]() { cleanupParallelRecording(); });
+
+    initGPUTiming();
+    _deletionStack.push([this]() { cleanupGPUTiming(); });
+
     // initial layout comes from separate render passes,
     // final layout depends on tetra mode.
     VkImageLayout imguiInitialLayout, imguiFinalLayout;
@@ -336,8 +424,10 @@ VkInstance Tetrium::createInstance()
     createInfo.pApplicationInfo = &appInfo;
 
     std::vector<const char*> instanceExtensions = DEFAULT_INSTANCE_EXTENSIONS;
-    // get glfw Extensions
-    {
+    if (_tetraMode != TetraMode::kHeadless) { // get presentation & glfw Extensions
+        for (const char* extension : PRESENTATION_INSTANCE_EXTENSIONS) {
+            instanceExtensions.push_back(extension);
+        }
         uint32_t glfwExtensionCount = 0;
         const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
         for (int i = 0; i < glfwExtensionCount; i++) {
@@ -507,6 +597,9 @@ bool Tetrium::isDeviceSuitable(VkPhysicalDevice device)
         deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU
         && deviceFeatures.geometryShader && deviceFeatures.multiDrawIndirect;
 #endif // __APPLE__
+    if (_tetraMode == TetraMode::kHeadless) { // software rasterizers e.g. lavapipe will do
+        platformRequirements = deviceFeatures.multiDrawIndirect;
+    }
 
     // check queue families
     if (platformRequirements) {
@@ -521,9 +614,28 @@ bool Tetrium::isDeviceSuitable(VkPhysicalDevice device)
     }
 }
 
+bool Tetrium::checkMultiviewSupport()
+{
+    if (!_device->IsExtensionEnabled(VK_KHR_MULTIVIEW_EXTENSION_NAME)) {
+        INFO("Multiview unsupported, color spaces are rendered in separate passes.");
+        return false;
+    }
+    const char* shader = InitContext{}.FRAGMENT_SHADER_MULTIVIEW_SRC;
+    if (!std::filesystem::exists(shader)) {
+        WARN("{} not found, compile shaders to enable multiview rendering.", shader);
+        return false;
+    }
+    return true;
+}
+
 const std::vector<const char*> Tetrium::getRequiredDeviceExtensions() const
 {
     std::vector<const char*> extensions = DEFAULT_DEVICE_EXTENSIONS;
+    if (_tetraMode != TetraMode::kHeadless) {
+        for (auto extension : PRESENTATION_DEVICE_EXTENSIONS) {
+            extensions.push_back(extension);
+        }
+    }
     if (_tetraMode == TetraMode::kEvenOddHardwareSync) {
         for (auto extension : EVEN_ODD_HARDWARE_DEVICE_EXTENSIONS) {
             extensions.push_back(extension);
@@ -643,12 +755,29 @@ void Tetrium::createSwapChain(Tetrium::SwapChainContext& ctx, const VkSurfaceKHR
     DEBUG("Swap chain created!");
 }
 
+void Tetrium::createHeadlessSwapChain(Tetrium::SwapChainContext& ctx, VkExtent2D extent)
+{
+    DEBUG("creating headless swapchain...");
+    ctx.chain = VK_NULL_HANDLE;
+    ctx.surface = VK_NULL_HANDLE;
+    ctx.extent = extent;
+    ctx.imageFormat = VK_FORMAT_B8G8R8A8_SRGB; // same as `chooseSwapSurfaceFormat()`'s preference
+    // one virtual frame buffer per frame in flight; images are never acquired nor presented
+    ctx.numImages = NUM_FRAME_IN_FLIGHT;
+    ctx.image.clear();
+    ctx.imageView.clear();
+    ctx.frameBuffer.clear();
+    DEBUG("extent: {} {}", extent.width, extent.height);
+}
+
 void Tetrium::cleanupSwapChain(SwapChainContext& ctx)
 {
     DEBUG("Cleaning up swap chain...");
-    vkDestroyImageView(_device->logicalDevice, ctx.depthImageView, nullptr);
-    vkDestroyImage(_device->logicalDevice, ctx.depthImage, nullptr);
-    vkFreeMemory(_device->logicalDevice, ctx.depthImageMemory, nullptr);
+    for (size_t i = 0; i < ctx.depthImage.size(); i++) {
+        vkDestroyImageView(_device->logicalDevice, ctx.depthImageView[i], nullptr);
+        vkDestroyImage(_device->logicalDevice, ctx.depthImage[i], nullptr);
+        vkFreeMemory(_device->logicalDevice, ctx.depthImageMemory[i], nullptr);
+    }
 
     for (VkFramebuffer framebuffer : ctx.frameBuffer) {
         vkDestroyFramebuffer(this->_device->logicalDevice, framebuffer, nullptr);
@@ -656,18 +785,33 @@ void Tetrium::cleanupSwapChain(SwapChainContext& ctx)
     for (VkImageView imageView : ctx.imageView) {
         vkDestroyImageView(this->_device->logicalDevice, imageView, nullptr);
     }
-    vkDestroySwapchainKHR(this->_device->logicalDevice, ctx.chain, nullptr);
+    if (ctx.chain != VK_NULL_HANDLE) { // headless swapchains have no chain
+        vkDestroySwapchainKHR(this->_device->logicalDevice, ctx.chain, nullptr);
+    }
 }
 
 void Tetrium::recreateVirtualFrameBuffers()
 {
     for (RenderContext* ctx : {&_renderContexts[RGB], &_renderContexts[OCV]}) {
         clearVirtualFrameBuffer(ctx->virtualFrameBuffer);
-        createVirtualFrameBuffer(ctx->renderPass, _swapChain, ctx->virtualFrameBuffer);
+    }
+    const MultiviewFrameBuffer* multiview = nullptr;
+    if (_multiviewCtx.supported) { // virtual frame buffers view into the multiview images
+        clearMultiviewFrameBuffer(_multiviewCtx.frameBuffer);
+        createMultiviewFrameBuffer(_multiviewCtx.renderPass, _swapChain, _multiviewCtx.frameBuffer);
+        multiview = &_multiviewCtx.frameBuffer;
+    }
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        RenderContext& ctx = _renderContexts[cs];
+        createVirtualFrameBuffer(ctx.renderPass, _swapChain, ctx.virtualFrameBuffer, multiview, cs);
     }
 
     // imgui's fb are associated with render contexts, so initialize them here
     reinitImGuiFrameBuffers(_imguiCtx);
+
+    // copy commands reference both the virtual and the swapchain images
+    freeSwapchainCopyCommandBuffers();
+    recordSwapchainCopyCommandBuffers();
 }
 
 void Tetrium::recreateSwapChain(SwapChainContext& ctx)
@@ -677,19 +821,28 @@ void Tetrium::recreateSwapChain(SwapChainContext& ctx)
     DEBUG("Recreating swap chain...");
     // handle window minimization
     int width = 0, height = 0;
-    glfwGetFramebufferSize(_window, &width, &height);
+    getFramebufferSize(width, height);
     while (width == 0 || height == 0) { // when the window is minimized, wait for it to be restored
-        glfwGetFramebufferSize(_window, &width, &height);
-        glfwWaitEvents();
+        if (_renderThreadCtx.enabled) { // the main thread keeps handling events meanwhile
+            if (_renderThreadCtx.stop) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        } else {
+            glfwWaitEvents();
+        }
+        getFramebufferSize(width, height);
     }
     // wait for device to be idle
     vkDeviceWaitIdle(_device->logicalDevice);
+    stopPresentWaiter(); // no-op unless under linux software even-odd sync
     this->cleanupSwapChain(ctx);
 
     this->createSwapChain(ctx, ctx.surface);
     this->createImageViews(ctx);
     this->createDepthBuffer(ctx);
     this->createSwapchainFrameBuffers(ctx, _renderContexts[RGB].renderPass);
+    startPresentWaiter();
     DEBUG("Swap chain recreated.");
 }
 
@@ -731,7 +884,7 @@ VkExtent2D Tetrium::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilitie
         return capabilities.currentExtent;
     } else {
         int width, height;
-        glfwGetFramebufferSize(this->_window, &width, &height);
+        getFramebufferSize(width, height);
 
         VkExtent2D actualExtent = {static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
 
@@ -799,9 +952,6 @@ void Tetrium::createSynchronizationObjects(
         VK_CHECK_RESULT(
             vkCreateFence(_device->logicalDevice, &fenceInfo, nullptr, &primitive.fenceInFlight)
         );
-        VK_CHECK_RESULT(vkCreateFence(
-            _device->logicalDevice, &fenceInfo, nullptr, &primitive.fenceRenderFinished
-        ));
 
         // create vsync semahore as a timeline semaphore
         // VkSemaphoreTypeCreateInfo timelineCreateInfo{
@@ -828,7 +978,6 @@ void Tetrium::createSynchronizationObjects(
                 vkDestroySemaphore(this->_device->logicalDevice, sema, nullptr);
             }
             vkDestroyFence(this->_device->logicalDevice, primitive.fenceInFlight, nullptr);
-            vkDestroyFence(this->_device->logicalDevice, primitive.fenceRenderFinished, nullptr);
         }
     });
 }
@@ -842,7 +991,11 @@ void Tetrium::Cleanup()
 
 // create a render pass. The render pass will be pushed onto
 // the deletion stack.
-vk::RenderPass Tetrium::createRenderPass(const VkFormat imageFormat)
+vk::RenderPass Tetrium::createRenderPass(
+    const VkFormat imageFormat,
+    uint32_t viewMask,
+    bool imguiSubpass
+)
 {
     DEBUG("Creating render pass...");
     VkAttachmentDescription colorAttachment{};
@@ -858,7 +1011,11 @@ vk::RenderPass Tetrium::createRenderPass(const VkFormat imageFormat)
 
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
+    // without the imgui subpass, imgui's own pass picks up from here
     colorAttachment.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    if (imguiSubpass) { // done with rendering; the virtual fb gets transferred to the swapchain
+        colorAttachment.finalLayout = getVirtualFrameBufferFinalLayout();
+    }
 
     VkAttachmentReference colorAttachmentRef{};
     colorAttachmentRef.attachment = 0;
@@ -879,24 +1036,47 @@ vk::RenderPass Tetrium::createRenderPass(const VkFormat imageFormat)
     depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
     // set up subpass
 
-    VkSubpassDescription subpass{};
+    std::vector<VkSubpassDescription> subpasses(1);
+    VkSubpassDescription& subpass = subpasses[0];
     subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
     subpass.colorAttachmentCount = 1;
     subpass.pColorAttachments = &colorAttachmentRef;
     subpass.pDepthStencilAttachment = &depthAttachmentRef;
 
     // dependency to make sure that the render pass waits for the image to
-    // be available before drawing
+    // be available before drawing; hazards against the previous frame's swapchain copy
+    // are covered by the frame graph's barriers, which end at the attachment stages
     VkSubpassDependency dependency{};
     dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
     dependency.dstSubpass = 0;
     dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
-                              | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+                              | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
+                              | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
     dependency.srcAccessMask = 0;
     dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
                               | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
     dependency.dstAccessMask
         = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    std::vector<VkSubpassDependency> dependencies = {dependency};
+
+    if (imguiSubpass) { // imgui draws over the scene, staying on-tile
+        VkSubpassDescription imguiSubpassDescription{};
+        imguiSubpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        imguiSubpassDescription.colorAttachmentCount = 1;
+        imguiSubpassDescription.pColorAttachments = &colorAttachmentRef;
+        subpasses.push_back(imguiSubpassDescription);
+
+        VkSubpassDependency sceneToImGui{};
+        sceneToImGui.srcSubpass = 0;
+        sceneToImGui.dstSubpass = 1;
+        sceneToImGui.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        sceneToImGui.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        sceneToImGui.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+        sceneToImGui.dstAccessMask
+            = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        sceneToImGui.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+        dependencies.push_back(sceneToImGui);
+    }
 
     std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
 
@@ -904,10 +1084,23 @@ vk::RenderPass Tetrium::createRenderPass(const VkFormat imageFormat)
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
     renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
     renderPassInfo.pAttachments = attachments.data();
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpass;
-    renderPassInfo.dependencyCount = 1;
-    renderPassInfo.pDependencies = &dependency;
+    renderPassInfo.subpassCount = static_cast<uint32_t>(subpasses.size());
+    renderPassInfo.pSubpasses = subpasses.data();
+    renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    renderPassInfo.pDependencies = dependencies.data();
+
+    // multiview: the subpass broadcasts to every view in VIEWMASK,
+    // views are correlated as they share the same geometry
+    VkRenderPassMultiviewCreateInfo multiviewInfo{};
+    multiviewInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO;
+    multiviewInfo.subpassCount = 1;
+    multiviewInfo.pViewMasks = &viewMask;
+    multiviewInfo.correlationMaskCount = 1;
+    multiviewInfo.pCorrelationMasks = &viewMask;
+    if (viewMask != 0) {
+        ASSERT(!imguiSubpass); // imgui differs per view
+        renderPassInfo.pNext = &multiviewInfo;
+    }
 
     VkRenderPass pass = VK_NULL_HANDLE;
     VK_CHECK_RESULT(vkCreateRenderPass(_device->logicalDevice, &renderPassInfo, nullptr, &pass));
@@ -937,7 +1130,9 @@ uint32_t findMemoryType(
 void Tetrium::createVirtualFrameBuffer(
     VkRenderPass renderPass,
     const SwapChainContext& swapChain,
-    VirtualFrameBuffer& vfb
+    VirtualFrameBuffer& vfb,
+    const MultiviewFrameBuffer* multiview,
+    uint32_t layer
 )
 {
     DEBUG("Creating framebuffers..");
@@ -950,47 +1145,57 @@ void Tetrium::createVirtualFrameBuffer(
     vfb.image.resize(numFrameBuffers);
     vfb.imageView.resize(numFrameBuffers);
     vfb.imageMemory.resize(numFrameBuffers); // Add this line for image memory
+    vfb.renderTick.assign(numFrameBuffers, VirtualFrameBuffer::NEVER_RENDERED);
+    vfb.layer = multiview ? layer : 0; // standalone images have a single layer
     for (size_t i = 0; i < numFrameBuffers; i++) {
-        VkImageCreateInfo imageInfo{};
-        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-        imageInfo.imageType = VK_IMAGE_TYPE_2D;
-        imageInfo.extent.width = swapChain.extent.width;
-        imageInfo.extent.height = swapChain.extent.height;
-        imageInfo.extent.depth = 1;
-        imageInfo.mipLevels = 1;
-        imageInfo.arrayLayers = 1;
-        imageInfo.format = swapChain.imageFormat;
-        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-        if (vkCreateImage(_device->logicalDevice, &imageInfo, nullptr, &vfb.image[i])
-            != VK_SUCCESS) {
-            FATAL("Failed to create custom image!");
-        }
+        if (multiview) { // borrow the multiview image
+            vfb.image[i] = multiview->image[i];
+            vfb.imageMemory[i] = VK_NULL_HANDLE;
+        } else {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent.width = swapChain.extent.width;
+            imageInfo.extent.height = swapChain.extent.height;
+            imageInfo.extent.depth = 1;
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = swapChain.imageFormat;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage
+                = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            if (vkCreateImage(_device->logicalDevice, &imageInfo, nullptr, &vfb.image[i])
+                != VK_SUCCESS) {
+                FATAL("Failed to create custom image!");
+            }
 
-        // Allocate memory for the image
-        VkMemoryRequirements memRequirements;
-        vkGetImageMemoryRequirements(_device->logicalDevice, vfb.image[i], &memRequirements);
+            // Allocate memory for the image
+            VkMemoryRequirements memRequirements;
+            vkGetImageMemoryRequirements(_device->logicalDevice, vfb.image[i], &memRequirements);
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = memRequirements.size;
+            allocInfo.memoryTypeIndex = findMemoryType(
+                _device->physicalDevice,
+                memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            );
 
-        VkMemoryAllocateInfo allocInfo{};
-        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = findMemoryType(
-            _device->physicalDevice,
-            memRequirements.memoryTypeBits,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-        );
+            if (vkAllocateMemory(
+                    _device->logicalDevice, &allocInfo, nullptr, &vfb.imageMemory[i]
+                )
+                != VK_SUCCESS) {
+                FATAL("Failed to allocate image memory!");
+            }
 
-        if (vkAllocateMemory(_device->logicalDevice, &allocInfo, nullptr, &vfb.imageMemory[i])
-            != VK_SUCCESS) {
-            FATAL("Failed to allocate image memory!");
+            vkBindImageMemory(_device->logicalDevice, vfb.image[i], vfb.imageMemory[i], 0);
         }
 
-        vkBindImageMemory(_device->logicalDevice, vfb.image[i], vfb.imageMemory[i], 0);
-
         // Create image view
         VkImageViewCreateInfo viewInfo{};
         viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -1000,14 +1205,14 @@ void Tetrium::createVirtualFrameBuffer(
         viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
         viewInfo.subresourceRange.baseMipLevel = 0;
         viewInfo.subresourceRange.levelCount = 1;
-        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.baseArrayLayer = vfb.layer;
         viewInfo.subresourceRange.layerCount = 1;
 
         if (vkCreateImageView(_device->logicalDevice, &viewInfo, nullptr, &vfb.imageView[i])
             != VK_SUCCESS) {
             FATAL("Failed to create custom image view!");
         }
-        VkImageView attachments[] = {vfb.imageView[i], swapChain.depthImageView};
+        VkImageView attachments[] = {vfb.imageView[i], swapChain.depthImageView[i]};
         VkFramebufferCreateInfo framebufferInfo{};
         framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         framebufferInfo.renderPass = renderPass; // each framebuffer is associated with a
@@ -1039,17 +1244,288 @@ void Tetrium::clearVirtualFrameBuffer(VirtualFrameBuffer& vfb)
     for (size_t i = 0; i < numFrameBuffers; i++) {
         vkDestroyFramebuffer(_device->logicalDevice, vfb.frameBuffer[i], NULL);
         vkDestroyImageView(_device->logicalDevice, vfb.imageView[i], NULL);
-        vkDestroyImage(_device->logicalDevice, vfb.image[i], NULL);
-        vkFreeMemory(_device->logicalDevice, vfb.imageMemory[i], NULL);
+        if (vfb.imageMemory[i] != VK_NULL_HANDLE) { // otherwise owned by the multiview fb
+            vkDestroyImage(_device->logicalDevice, vfb.image[i], NULL);
+            vkFreeMemory(_device->logicalDevice, vfb.imageMemory[i], NULL);
+        }
+    }
+}
+
+void Tetrium::createMultiviewFrameBuffer(
+    VkRenderPass renderPass,
+    const SwapChainContext& swapChain,
+    MultiviewFrameBuffer& mfb
+)
+{
+    DEBUG("Creating multiview framebuffers..");
+    ASSERT(renderPass != VK_NULL_HANDLE);
+    size_t numFrameBuffers = swapChain.numImages;
+    ASSERT(numFrameBuffers != 0);
+    const uint32_t numLayers = ColorSpace::ColorSpaceSize; // one view per color space
+    VkFormat depthFormat = VulkanUtils::findDepthFormat(_device->physicalDevice);
+
+    auto createImageArray = [&](VkFormat format,
+                                VkImageUsageFlags usage,
+                                VkImageAspectFlags aspect,
+                                VkImage& image,
+                                VkDeviceMemory& memory,
+                                VkImageView& view) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = swapChain.extent.width;
+        imageInfo.extent.height = swapChain.extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = numLayers;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = usage;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VK_CHECK_RESULT(vkCreateImage(_device->logicalDevice, &imageInfo, nullptr, &image));
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(_device->logicalDevice, image, &memRequirements);
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        if (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
+            allocInfo.memoryTypeIndex = VulkanUtils::findTransientAttachmentMemoryType(
+                _device->physicalDevice, memRequirements.memoryTypeBits
+            );
+        } else {
+            allocInfo.memoryTypeIndex = findMemoryType(
+                _device->physicalDevice,
+                memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+            );
+        }
+        VK_CHECK_RESULT(vkAllocateMemory(_device->logicalDevice, &allocInfo, nullptr, &memory));
+        vkBindImageMemory(_device->logicalDevice, image, memory, 0);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = numLayers;
+        VK_CHECK_RESULT(vkCreateImageView(_device->logicalDevice, &viewInfo, nullptr, &view));
+    };
+
+    mfb.frameBuffer.resize(numFrameBuffers);
+    mfb.image.resize(numFrameBuffers);
+    mfb.imageView.resize(numFrameBuffers);
+    mfb.imageMemory.resize(numFrameBuffers);
+    mfb.depthImage.resize(numFrameBuffers);
+    mfb.depthImageView.resize(numFrameBuffers);
+    mfb.depthImageMemory.resize(numFrameBuffers);
+    for (size_t i = 0; i < numFrameBuffers; i++) {
+        createImageArray(
+            swapChain.imageFormat,
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            mfb.image[i],
+            mfb.imageMemory[i],
+            mfb.imageView[i]
+        );
+        // depth never outlives the pass, it may stay on-tile
+        createImageArray(
+            depthFormat,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            mfb.depthImage[i],
+            mfb.depthImageMemory[i],
+            mfb.depthImageView[i]
+        );
+
+        VkImageView attachments[] = {mfb.imageView[i], mfb.depthImageView[i]};
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPass;
+        framebufferInfo.attachmentCount = sizeof(attachments) / sizeof(VkImageView);
+        framebufferInfo.pAttachments = attachments;
+        framebufferInfo.width = swapChain.extent.width;
+        framebufferInfo.height = swapChain.extent.height;
+        framebufferInfo.layers = 1; // multiview framebuffers must have a single layer
+        VK_CHECK_RESULT(vkCreateFramebuffer(
+            _device->logicalDevice, &framebufferInfo, nullptr, &mfb.frameBuffer[i]
+        ));
+    }
+}
+
+void Tetrium::clearMultiviewFrameBuffer(MultiviewFrameBuffer& mfb)
+{
+    for (size_t i = 0; i < mfb.frameBuffer.size(); i++) {
+        vkDestroyFramebuffer(_device->logicalDevice, mfb.frameBuffer[i], NULL);
+        vkDestroyImageView(_device->logicalDevice, mfb.imageView[i], NULL);
+        vkDestroyImage(_device->logicalDevice, mfb.image[i], NULL);
+        vkFreeMemory(_device->logicalDevice, mfb.imageMemory[i], NULL);
+        vkDestroyImageView(_device->logicalDevice, mfb.depthImageView[i], NULL);
+        vkDestroyImage(_device->logicalDevice, mfb.depthImage[i], NULL);
+        vkFreeMemory(_device->logicalDevice, mfb.depthImageMemory[i], NULL);
+    }
+    mfb = MultiviewFrameBuffer{};
+}
+
+void Tetrium::recordSwapchainCopyCommandBuffers()
+{
+    if (_swapChain.chain == VK_NULL_HANDLE) { // headless, nothing to copy onto
+        return;
+    }
+    DEBUG("Recording swapchain copy command buffers...");
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        RenderContext& ctx = _renderContexts[cs];
+        ASSERT(ctx.swapchainCopyCommandBuffers.empty());
+        ASSERT(ctx.virtualFrameBuffer.image.size() == _swapChain.numImages);
+        ctx.swapchainCopyCommandBuffers.resize(_swapChain.numImages);
+        VulkanUtils::createCommandBuffers(
+            ctx.swapchainCopyCommandBuffers,
+            _swapChain.numImages,
+            _device->graphicsCommandPool,
+            _device->logicalDevice
+        );
+        for (size_t i = 0; i < _swapChain.numImages; i++) {
+            VkCommandBuffer cb = ctx.swapchainCopyCommandBuffers[i];
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            // the same copy may be re-submitted before its previous submission retires
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+            VK_CHECK_RESULT(vkBeginCommandBuffer(cb, &beginInfo));
+
+            // the render submission's semaphore already made the virtual frame buffer visible;
+            // the swapchain image is waited on at the transfer stage and its content discarded
+            FrameGraph graph;
+            graph.Init(_device->logicalDevice, _frameGraph.IsSynchronization2());
+            VkImage vfbImage = ctx.virtualFrameBuffer.image[i];
+            VkImage swapchainImage = _swapChain.image[i];
+            FrameGraph::ResourceId vfb = graph.ImportImage(
+                vfbImage,
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                ctx.virtualFrameBuffer.layer,
+                {VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                 VK_ACCESS_2_NONE,
+                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL}
+            );
+            FrameGraph::ResourceId swapchain = graph.ImportImage(
+                swapchainImage,
+                VK_IMAGE_ASPECT_COLOR_BIT,
+                0,
+                {VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_NONE, VK_IMAGE_LAYOUT_UNDEFINED}
+            );
+            graph.Export(swapchain, FrameGraph::kPresent);
+            uint32_t layer = ctx.virtualFrameBuffer.layer;
+            graph.AddPass(
+                "Copy to swapchain",
+                {{vfb, FrameGraph::kTransferSrc}, {swapchain, FrameGraph::kTransferDst}},
+                [this, vfbImage, swapchainImage, layer](VkCommandBuffer copyCB) {
+                    Utils::ImageTransfer::CmdCopyImage(
+                        copyCB, vfbImage, swapchainImage, _swapChain.extent, layer
+                    );
+                }
+            );
+            graph.Execute(cb);
+
+            VK_CHECK_RESULT(vkEndCommandBuffer(cb));
+        }
+    }
+}
+
+void Tetrium::freeSwapchainCopyCommandBuffers()
+{
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        std::vector<VkCommandBuffer>& cbs = _renderContexts[cs].swapchainCopyCommandBuffers;
+        if (!cbs.empty()) {
+            vkFreeCommandBuffers(
+                _device->logicalDevice, _device->graphicsCommandPool, cbs.size(), cbs.data()
+            );
+        }
+        cbs.clear();
+    }
+}
+
+void Tetrium::initParallelRecording()
+{
+    DEBUG("Initializing parallel command recording...");
+    uint32_t queueFamilyIndex = _device->queueFamilyIndices.graphicsFamily.value();
+    // pools are reset as a whole once their frame's fence signals
+    auto createSecondary = [this, queueFamilyIndex](VkCommandPool& pool, VkCommandBuffer& cb) {
+        VulkanUtils::createCommandPool(&pool, 0, queueFamilyIndex, _device->logicalDevice);
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandPool = pool;
+        allocInfo.commandBufferCount = 1;
+        VK_CHECK_RESULT(vkAllocateCommandBuffers(_device->logicalDevice, &allocInfo, &cb));
+    };
+    for (auto& frameCommands : _parallelRecordingCtx.secondaryCommands) {
+        for (SecondaryCommandContext& commands : frameCommands) {
+            createSecondary(commands.scenePool, commands.sceneCB);
+            createSecondary(commands.imguiPool, commands.imguiCB);
+        }
     }
+    // one worker per color space; imgui gets recorded on the calling thread
+    _threadPool.Init(ColorSpace::ColorSpaceSize);
 }
 
+void Tetrium::cleanupParallelRecording()
+{
+    _threadPool.Cleanup();
+    for (auto& frameCommands : _parallelRecordingCtx.secondaryCommands) {
+        for (SecondaryCommandContext& commands : frameCommands) {
+            // destroying the pool frees its command buffers
+            vkDestroyCommandPool(_device->logicalDevice, commands.scenePool, nullptr);
+            vkDestroyCommandPool(_device->logicalDevice, commands.imguiPool, nullptr);
+            commands = SecondaryCommandContext{};
+        }
+    }
+}
+
+void Tetrium::initGPUTiming()
+{
+    uint32_t queueFamily = _device->queueFamilyIndices.graphicsFamily.value();
+    uint32_t timestampValidBits = _device->queueFamilyProperties[queueFamily].timestampValidBits;
+    _clockDomains.Init(
+        _instance,
+        _device->physicalDevice,
+        _device->logicalDevice,
+        _device->IsExtensionEnabled(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME),
+        timestampValidBits
+    );
+    _lastClockCalibration = std::chrono::steady_clock::now();
+    if (_clockDomains.IsDeviceCalibrated()) {
+        INFO(
+            "GPU timestamps calibrated against the host clock, max deviation {} ns",
+            _clockDomains.GetCalibration()->maxDeviationNanoSeconds
+        );
+    } else {
+        INFO("GPU timestamps uncalibrated, GPU profiler entries only keep their durations.");
+    }
+    _gpuProfiler.Init(
+        _device->logicalDevice,
+        queueFamily,
+        timestampValidBits,
+        _device->properties.limits.timestampPeriod,
+        NUM_FRAME_IN_FLIGHT
+    );
+    if (!_gpuProfiler.IsSupported()) {
+        INFO("Graphics queue does not support timestamps, GPU timing disabled.");
+    }
+}
+
+void Tetrium::cleanupGPUTiming() { _gpuProfiler.Cleanup(); }
+
 void Tetrium::createSwapchainFrameBuffers(SwapChainContext& ctx, VkRenderPass rgbOrOcvPass)
 {
     DEBUG("Creating framebuffers..");
     // iterate through image views and create framebuffers
     for (size_t i = 0; i < ctx.image.size(); i++) {
-        VkImageView attachments[] = {ctx.imageView[i], ctx.depthImageView};
+        VkImageView attachments[] = {ctx.imageView[i], ctx.depthImageView[i]};
         VkFramebufferCreateInfo framebufferInfo{};
         framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
         // NOTE: framebuffer DOES NOT need to have a dedicated render pass,
@@ -1071,28 +1547,35 @@ void Tetrium::createSwapchainFrameBuffers(SwapChainContext& ctx, VkRenderPass rg
 
 void Tetrium::createDepthBuffer(SwapChainContext& ctx)
 {
-    DEBUG("Creating depth buffer...");
+    DEBUG("Creating depth buffers...");
     VkFormat depthFormat = VulkanUtils::findBestFormat(
         {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
         VK_IMAGE_TILING_OPTIMAL,
         VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT,
         _device->physicalDevice
     );
-    VulkanUtils::createImage(
-        ctx.extent.width,
-        ctx.extent.height,
-        depthFormat,
-        VK_IMAGE_TILING_OPTIMAL,
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        ctx.depthImage,
-        ctx.depthImageMemory,
-        _device->physicalDevice,
-        _device->logicalDevice
-    );
-    ctx.depthImageView = VulkanUtils::createImageView(
-        ctx.depthImage, _device->logicalDevice, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT
-    );
+    ASSERT(ctx.numImages != 0);
+    ctx.depthImage.resize(ctx.numImages);
+    ctx.depthImageMemory.resize(ctx.numImages);
+    ctx.depthImageView.resize(ctx.numImages);
+    for (size_t i = 0; i < ctx.numImages; i++) {
+        VulkanUtils::createImage(
+            ctx.extent.width,
+            ctx.extent.height,
+            depthFormat,
+            VK_IMAGE_TILING_OPTIMAL,
+            // cleared on load and never stored, so it may stay on-tile
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            ctx.depthImage[i],
+            ctx.depthImageMemory[i],
+            _device->physicalDevice,
+            _device->logicalDevice
+        );
+        ctx.depthImageView[i] = VulkanUtils::createImageView(
+            ctx.depthImage[i], _device->logicalDevice, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT
+        );
+    }
 }
 
 // FIXME: glfw calls from a differnt thread; may need to add critical sections
@@ -14,17 +14,18 @@ const std::vector<const char*> Tetrium::DEFAULT_INSTANCE_EXTENSIONS = {
 #ifndef NDEBUG
     VK_EXT_DEBUG_UTILS_EXTENSION_NAME,
 #endif // NDEBUG
+    // molten vk support, and dependency of VK_KHR_multiview
+    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+};
+
+const std::vector<const char*> Tetrium::PRESENTATION_INSTANCE_EXTENSIONS = {
     VK_KHR_SURFACE_EXTENSION_NAME,
 #ifdef __linux__
     VK_KHR_DISPLAY_EXTENSION_NAME,
 #endif  // __linux__
-#if __APPLE__ // molten vk support
-    VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
-#endif // __APPLE__
 };
 
 const std::vector<const char*> Tetrium::DEFAULT_DEVICE_EXTENSIONS = {
-    VK_KHR_SWAPCHAIN_EXTENSION_NAME,
     VK_KHR_SHADER_NON_SEMANTIC_INFO_EXTENSION_NAME,
 #if __APPLE__ // molten vk support
     VK_KHR_PORTABILITY_SUBSET_EXTENSION_NAME,
@@ -33,6 +34,19 @@ const std::vector<const char*> Tetrium::DEFAULT_DEVICE_EXTENSIONS = {
     //VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, // for softare side v-sync
 };
 
+const std::vector<const char*> Tetrium::PRESENTATION_DEVICE_EXTENSIONS = {
+    VK_KHR_SWAPCHAIN_EXTENSION_NAME,
+};
+
+const std::vector<const char*> Tetrium::OPTIONAL_DEVICE_EXTENSIONS = {
+    // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_multiview.html
+    VK_KHR_MULTIVIEW_EXTENSION_NAME, // render both color spaces in a single pass
+    // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_synchronization2.html
+    VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME, // frame graph barriers
+    // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_calibrated_timestamps.html
+    VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME, // GPU timestamps on the CPU's timeline
+};
+
 const std::vector<const char*> Tetrium::EVEN_ODD_HARDWARE_INSTANCE_EXTENSIONS = {
 // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_EXT_display_surface_counter.html
 #if __linux__
@@ -56,5 +70,12 @@ const std::vector<const char*> Tetrium::EVEN_ODD_SOFTWARE_DEVICE_EXTENSIONS = {
     // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/vkGetRefreshCycleDurationGOOGLE.html
     // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/vkGetPastPresentationTimingGOOGLE.html
     // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkPresentTimesInfoGOOGLE.html
+#if __linux__ // not implemented by mesa
+    // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_present_id.html
+    // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VK_KHR_present_wait.html
+    VK_KHR_PRESENT_ID_EXTENSION_NAME,   // tag each present
+    VK_KHR_PRESENT_WAIT_EXTENSION_NAME, // wait for a tagged present to be displayed
+#else
     VK_GOOGLE_DISPLAY_TIMING_EXTENSION_NAME, // for query refresh rate
+#endif // __linux__
 };
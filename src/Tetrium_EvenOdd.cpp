@@ -1,5 +1,6 @@
 // Even-Odd frame rendering implementations
 #include "Tetrium.h"
+#include "lib/Utils.h"
 
 void Tetrium::initEvenOdd()
 {
@@ -12,6 +13,9 @@ void Tetrium::initEvenOdd()
         checkSoftwareEvenOddFrameSupport();
         setupSoftwareEvenOddFrame();
         break;
+    case TetraMode::kEvenOddVirtualSync: // the simulation needs no device support
+        startVblankThread();
+        break;
     default:
         break;
     }
@@ -19,7 +23,8 @@ void Tetrium::initEvenOdd()
 
 void Tetrium::cleanupEvenOdd()
 {
-    return; // nothing needs to be cleaned up
+    stopPresentWaiter(); // waits on the swapchain, must go before it
+    stopVblankThread();
 }
 
 void Tetrium::setupSoftwareEvenOddFrame()
@@ -28,6 +33,24 @@ void Tetrium::setupSoftwareEvenOddFrame()
     auto& ctx = _softwareEvenOddCtx;
     ctx.timeEngineStart = std::chrono::steady_clock::now();
 
+#if __linux__ // count vblanks from present completions, see `_presentWaitCtx`
+    _presentWaitCtx.vkWaitForPresentKHR = reinterpret_cast<PFN_vkWaitForPresentKHR>(
+        vkGetDeviceProcAddr(_device->logicalDevice, "vkWaitForPresentKHR")
+    );
+    if (_presentWaitCtx.vkWaitForPresentKHR == nullptr) {
+        PANIC("Failed to get function pointer to {}", "vkWaitForPresentKHR");
+    }
+    // starting point for the refresh period, the present waiter refines it:
+    // glfw rounds the refresh rate to an integer, e.g. 59.94Hz reports as 60Hz
+    GLFWmonitor* monitor = glfwGetWindowMonitor(_window);
+    const GLFWvidmode* mode = glfwGetVideoMode(monitor ? monitor : glfwGetPrimaryMonitor());
+    ASSERT(mode && mode->refreshRate > 0);
+    ctx.nanoSecondsPerFrame = 1'000'000'000ull / mode->refreshRate;
+    _presentWaitCtx.refreshPeriodNanoSeconds = ctx.nanoSecondsPerFrame;
+    startPresentWaiter();
+    return;
+#endif // __linux__
+
     // get refresh cycle
     VkRefreshCycleDurationGOOGLE refreshCycleDuration;
     ASSERT(_device->logicalDevice);
@@ -39,9 +62,153 @@ void Tetrium::setupSoftwareEvenOddFrame()
     VK_CHECK_RESULT(ptr(_device->logicalDevice, _swapChain.chain, &refreshCycleDuration));
     ctx.nanoSecondsPerFrame = refreshCycleDuration.refreshDuration;
     ASSERT(ctx.nanoSecondsPerFrame != 0);
+
+    ctx.vkGetPastPresentationTimingGOOGLE = reinterpret_cast<PFN_vkGetPastPresentationTimingGOOGLE>(
+        vkGetInstanceProcAddr(_instance, "vkGetPastPresentationTimingGOOGLE")
+    );
+    if (ctx.vkGetPastPresentationTimingGOOGLE == nullptr) {
+        PANIC("Failed to get function pointer to {}", "vkGetPastPresentationTimingGOOGLE");
+    }
+    ctx.pastPresentationTimings.resize(_swapChain.numImages);
+}
+
+void Tetrium::checkSoftwareEvenOddFrameSupport()
+{
+#if __linux__ // the extensions being enabled doesn't imply their features are supported
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR
+    };
+    VkPhysicalDevicePresentIdFeaturesKHR presentIdFeatures{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR,
+        .pNext = &presentWaitFeatures
+    };
+    VkPhysicalDeviceFeatures2 features{
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &presentIdFeatures
+    };
+    vkGetPhysicalDeviceFeatures2(_device->physicalDevice, &features);
+    if (!presentIdFeatures.presentId || !presentWaitFeatures.presentWait) {
+        PANIC("Software even-odd frame requires presentId and presentWait!");
+    }
+#endif // __linux__
+}
+
+void Tetrium::startPresentWaiter()
+{
+    auto& ctx = _presentWaitCtx;
+    if (ctx.vkWaitForPresentKHR == nullptr || ctx.thread.joinable()) {
+        return;
+    }
+    ctx.stop = false;
+    ctx.thread = std::thread([this]() { presentWaiterLoop(); });
 }
 
-void Tetrium::checkSoftwareEvenOddFrameSupport() {}
+void Tetrium::stopPresentWaiter()
+{
+    auto& ctx = _presentWaitCtx;
+    if (!ctx.thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(ctx.mutex);
+        ctx.stop = true;
+    }
+    ctx.cvSubmitted.notify_one();
+    ctx.thread.join();
+}
+
+uint64_t Tetrium::queuePresentId()
+{
+    auto& ctx = _presentWaitCtx;
+    uint64_t presentId;
+    {
+        std::lock_guard<std::mutex> lock(ctx.mutex);
+        presentId = ++ctx.submittedPresentId;
+    }
+    ctx.cvSubmitted.notify_one();
+    return presentId;
+}
+
+std::unique_lock<std::mutex> Tetrium::lockSwapchain()
+{
+    auto& ctx = _presentWaitCtx;
+    ctx.numSwapchainWaiters.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(ctx.swapchainMutex);
+    ctx.numSwapchainWaiters.fetch_sub(1, std::memory_order_relaxed);
+    return lock;
+}
+
+void Tetrium::presentWaiterLoop()
+{
+    auto& ctx = _presentWaitCtx;
+    uint64_t waitedPresentId; // last present id waited on
+    {
+        std::lock_guard<std::mutex> lock(ctx.mutex);
+        waitedPresentId = ctx.submittedPresentId;
+    }
+    std::optional<std::chrono::steady_clock::time_point> lastCompletion;
+
+    while (true) {
+        { // sleep until there's a present to wait on
+            std::unique_lock<std::mutex> lock(ctx.mutex);
+            ctx.cvSubmitted.wait(lock, [&ctx, waitedPresentId]() {
+                return ctx.stop || ctx.submittedPresentId > waitedPresentId;
+            });
+            if (ctx.stop) {
+                return;
+            }
+        }
+
+        // the swapchain only changes while this thread is stopped; acquire & present still use
+        // it, so each wait is short and gives way to them in between
+        uint64_t presentId = waitedPresentId + 1;
+        VkResult result;
+        {
+            std::lock_guard<std::mutex> lock(ctx.swapchainMutex);
+            result = ctx.vkWaitForPresentKHR(
+                _device->logicalDevice, _swapChain.chain, presentId, SWAPCHAIN_HOLD_NANOSECONDS
+            );
+        }
+        if (result == VK_TIMEOUT) {
+            while (ctx.numSwapchainWaiters.load(std::memory_order_relaxed) > 0) {
+                std::this_thread::yield();
+            }
+            continue;
+        }
+        waitedPresentId = presentId;
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) { // e.g. out of date
+            lastCompletion.reset();
+            continue;
+        }
+        auto now = std::chrono::steady_clock::now();
+        ctx.numPresentsCompleted.fetch_add(1, std::memory_order_relaxed);
+        if (!lastCompletion.has_value()) {
+            uint64_t counter = ctx.numVblanks.fetch_add(1, std::memory_order_release) + 1;
+            _vblankCtx.clock.Publish({counter, now});
+            lastCompletion = now;
+            continue;
+        }
+
+        // presents replaced under mailbox complete along with the one that got shown,
+        // rounding to 0 vblanks
+        double period = ctx.refreshPeriodNanoSeconds.load(std::memory_order_relaxed);
+        double interval
+            = std::chrono::duration<double, std::nano>(now - lastCompletion.value()).count();
+        uint64_t numVblanks = std::llround(interval / period);
+        if (numVblanks == 1) { // track the actual refresh rate
+            ctx.refreshPeriodNanoSeconds.store(
+                period * 0.99 + interval * 0.01, std::memory_order_relaxed
+            );
+        } else if (numVblanks > 1) { // the display repeated the previous frame
+            ctx.numRepeatedVblanks.fetch_add(numVblanks - 1, std::memory_order_relaxed);
+        }
+        if (numVblanks != 0) { // the completion is the closest we get to the vblank's time
+            uint64_t counter
+                = ctx.numVblanks.fetch_add(numVblanks, std::memory_order_release) + numVblanks;
+            _vblankCtx.clock.Publish({counter, now});
+            lastCompletion = now;
+        }
+    }
+}
 
 void Tetrium::setupHardwareEvenOddFrame()
 {
@@ -59,6 +226,114 @@ void Tetrium::setupHardwareEvenOddFrame()
     if (ctx.vkGetSwapchainCounterEXT == nullptr) {
         PANIC("Failed to get function pointer to {}", "vkGetSwapchainCounterEXT");
     }
+    _vblankCtx.vkRegisterDisplayEventEXT = reinterpret_cast<PFN_vkRegisterDisplayEventEXT>(
+        vkGetDeviceProcAddr(_device->logicalDevice, "vkRegisterDisplayEventEXT")
+    );
+    if (_vblankCtx.vkRegisterDisplayEventEXT == nullptr) {
+        PANIC("Failed to get function pointer to {}", "vkRegisterDisplayEventEXT");
+    }
+    startVblankThread();
+}
+
+void Tetrium::startVblankThread()
+{
+    ASSERT(!_vblankCtx.thread.joinable());
+    _vblankCtx.stop = false;
+    _vblankCtx.thread = std::thread([this]() { vblankThreadLoop(); });
+}
+
+void Tetrium::stopVblankThread()
+{
+    if (!_vblankCtx.thread.joinable()) {
+        return;
+    }
+    _vblankCtx.stop = true; // noticed within one wait timeout
+    _vblankCtx.thread.join();
+}
+
+void Tetrium::vblankThreadLoop()
+{
+    auto& ctx = _vblankCtx;
+    Utils::Thread::SetCurrentThreadName("tetrium-vblank");
+    ctx.realtime = Utils::Thread::SetCurrentThreadRealtime();
+    if (!ctx.realtime) {
+        WARN("Vblank thread runs at normal priority, its wake-ups may be late under load");
+    }
+    if (_tetraMode == TetraMode::kEvenOddVirtualSync) {
+        virtualVblankThreadLoop();
+        return;
+    }
+    // bounds how long stopping takes, and how long a display that stopped scanning out
+    // goes unnoticed
+    const uint64_t WAIT_TIMEOUT_NANOSECONDS = 100'000'000;
+
+    while (!ctx.stop) {
+        // display events are one-shot, each vblank needs a new fence
+        VkDisplayEventInfoEXT eventInfo{
+            .sType = VK_STRUCTURE_TYPE_DISPLAY_EVENT_INFO_EXT,
+            .displayEvent = VK_DISPLAY_EVENT_TYPE_FIRST_PIXEL_OUT_EXT
+        };
+        VkFence fence = VK_NULL_HANDLE;
+        VK_CHECK_RESULT(ctx.vkRegisterDisplayEventEXT(
+            _device->logicalDevice, _mainProjectorDisplay.display, &eventInfo, nullptr, &fence
+        ));
+        VkResult result
+            = vkWaitForFences(_device->logicalDevice, 1, &fence, VK_TRUE, WAIT_TIMEOUT_NANOSECONDS);
+        auto now = std::chrono::steady_clock::now();
+        vkDestroyFence(_device->logicalDevice, fence, nullptr);
+        if (result == VK_TIMEOUT) {
+            ctx.numTimeouts.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        VK_CHECK_RESULT(result);
+
+        // the swapchain is the render thread's, which lines the count up with its counter
+        uint64_t numVblanks = ctx.numVblanks.fetch_add(1, std::memory_order_release) + 1;
+        ctx.clock.Publish({numVblanks + ctx.counterOffset.load(std::memory_order_relaxed), now});
+        ctx.numEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Tetrium::virtualVblankThreadLoop()
+{
+    auto& ctx = _vblankCtx;
+    // bounds how long stopping takes under low simulated refresh rates
+    const std::chrono::milliseconds MAX_SLEEP(100);
+
+    while (!ctx.stop) {
+        auto nextVblank = _virtualDisplay.GetNextVblankTime();
+        if (nextVblank - std::chrono::steady_clock::now() > MAX_SLEEP) {
+            std::this_thread::sleep_for(MAX_SLEEP);
+            continue;
+        }
+        std::this_thread::sleep_until(nextVblank);
+        // publish the simulated vblank time, the wake-up itself may be late
+        VirtualDisplay::Vblank vblank = _virtualDisplay.GetLastVblank();
+        ctx.clock.Publish({vblank.counter, vblank.time});
+        ctx.numEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Tetrium::waitOutImminentVblank()
+{
+    auto& ctx = _vblankCtx;
+    std::optional<VblankClock::Sample> vblank = ctx.clock.Read();
+    uint64_t refreshPeriod = getRefreshPeriodNanoSeconds();
+    if (!ctx.pacedSubmission || !vblank.has_value() || refreshPeriod == 0) {
+        return;
+    }
+    auto nextVblank = vblank->time + std::chrono::nanoseconds(refreshPeriod);
+    auto now = std::chrono::steady_clock::now();
+    if (nextVblank - now > std::chrono::nanoseconds(ctx.submitGuardNanoSeconds)) {
+        return; // enough time for the copy to land before the vblank
+    }
+    // a parity sampled now may be stale by the time the copy lands, submit right after the
+    // vblank instead; give up after a period in case the display stopped scanning out
+    PROFILE_SCOPE(&_profiler, "Wait for vblank");
+    ctx.clock.WaitForVblankAfter(
+        vblank->counter, nextVblank + std::chrono::nanoseconds(refreshPeriod)
+    );
+    ctx.numPacedWaits++;
 }
 
 // check for hardware and software support for even-odd frame rendering.
@@ -141,19 +416,21 @@ uint64_t Tetrium::getSurfaceCounterValue()
 #if NEW_VIRTUAL_FRAMECOUNTER
 #if __APPLE__
 
-        PFN_vkGetPastPresentationTimingGOOGLE fnPtr = reinterpret_cast<PFN_vkGetPastPresentationTimingGOOGLE >(
-            vkGetInstanceProcAddr(_instance, "vkGetPastPresentationTimingGOOGLE")
-        );
-        fnPtr(
+        auto& ctx = _softwareEvenOddCtx;
+        ctx.vkGetPastPresentationTimingGOOGLE(
             _device->logicalDevice, _swapChain.chain, &imageCount, nullptr
         );
-        std::vector<VkPastPresentationTimingGOOGLE> images(imageCount);
-        fnPtr(
-            _device->logicalDevice, _swapChain.chain, &imageCount, images.data()
+        if (ctx.pastPresentationTimings.size() < imageCount) { // only grows, rarely
+            ctx.pastPresentationTimings.resize(imageCount);
+        }
+        ctx.vkGetPastPresentationTimingGOOGLE(
+            _device->logicalDevice,
+            _swapChain.chain,
+            &imageCount,
+            ctx.pastPresentationTimings.data()
         );
-        auto& ctx = _softwareEvenOddCtx;
         for (int i = 0; i < imageCount; i++) {
-            auto& img = images.at(i);
+            auto& img = ctx.pastPresentationTimings[i];
             if (img.presentID > ctx.lastPresentedImageId) {
                 ctx.numFramesPresented += 1;
                 ctx.lastPresentedImageId = img.presentID;
@@ -169,8 +446,10 @@ uint64_t Tetrium::getSurfaceCounterValue()
             // );
         }
         surfaceCounter = ctx.numFramesPresented;
-#else  // !__APPLE__
-        NEEDS_IMPLEMENTATION(); // only apple device supports software counter so far.
+#elif __linux__
+        surfaceCounter = _presentWaitCtx.numVblanks.load(std::memory_order_acquire);
+#else
+        NEEDS_IMPLEMENTATION();
 #endif // __APPLE__
 #else  // ! NEW_VIRTUAL_FRAMECOUNTER
        // old method: count the time
@@ -192,14 +471,24 @@ uint64_t Tetrium::getSurfaceCounterValue()
         NEEDS_IMPLEMENTATION();
 #endif
 #if __linux__
-        _hardWareEvenOddCtx.vkGetSwapchainCounterEXT(
-            _device->logicalDevice,
-            _swapChain.chain,
-            VkSurfaceCounterFlagBitsEXT::VK_SURFACE_COUNTER_VBLANK_EXT,
-            &surfaceCounter
-        );
+        {
+            uint64_t numVblanks = _vblankCtx.numVblanks.load(std::memory_order_acquire);
+            _hardWareEvenOddCtx.vkGetSwapchainCounterEXT(
+                _device->logicalDevice,
+                _swapChain.chain,
+                VkSurfaceCounterFlagBitsEXT::VK_SURFACE_COUNTER_VBLANK_EXT,
+                &surfaceCounter
+            );
+            alignVblankCounter(surfaceCounter, numVblanks);
+        }
 #endif
         break;
+    case TetraMode::kEvenOddVirtualSync:
+        surfaceCounter = _virtualDisplay.GetVblankCounter();
+        break;
+    case TetraMode::kHeadless: // synthetic counter, a vblank in between every tick
+        surfaceCounter = _numTicks;
+        break;
     default:
         surfaceCounter = 0;
     }
@@ -207,4 +496,235 @@ uint64_t Tetrium::getSurfaceCounterValue()
     return surfaceCounter;
 }
 
-bool Tetrium::isEvenFrame() { return getSurfaceCounterValue() % 2 == 0; }
+void Tetrium::alignVblankCounter(uint64_t counter, uint64_t numVblanks)
+{
+    // the counter ticks as blanking starts, a little before the vblank thread wakes up to it;
+    // only line the two up well clear of the next vblank
+    const std::chrono::milliseconds NEXT_VBLANK_GUARD(2);
+
+    auto& ctx = _vblankCtx;
+    std::optional<VblankClock::Sample> vblank = ctx.clock.Read();
+    uint64_t refreshPeriod = getRefreshPeriodNanoSeconds();
+    if (!vblank.has_value() || refreshPeriod == 0
+        || ctx.numVblanks.load(std::memory_order_acquire) != numVblanks) { // one came in between
+        return;
+    }
+    auto sinceVblank = std::chrono::steady_clock::now() - vblank->time;
+    if (sinceVblank > std::chrono::nanoseconds(refreshPeriod) - NEXT_VBLANK_GUARD) {
+        return;
+    }
+    ctx.counterOffset.store(counter - numVblanks, std::memory_order_relaxed); // wraps around
+}
+
+bool Tetrium::isEvenFrame() { return _timingSnapshot.surfaceCounter % 2 == 0; }
+
+void Tetrium::captureTimingSnapshot()
+{
+    TimingSnapshot& snapshot = _timingSnapshot;
+    snapshot.tick = _numTicks;
+    snapshot.surfaceCounter = getSurfaceCounterValue();
+    snapshot.captureTime = std::chrono::steady_clock::now();
+    snapshot.refreshPeriodNanoSeconds = getRefreshPeriodNanoSeconds();
+    bool isEven = snapshot.surfaceCounter % 2 == 0;
+    if (_flipEvenOdd) {
+        isEven = !isEven;
+    }
+    snapshot.colorSpace = isEven ? RGB : OCV;
+
+    snapshot.lastPresentTime.reset();
+    if (_tetraMode == TetraMode::kEvenOddSoftwareSync
+        && _softwareEvenOddCtx.mostRecentPresentFinish != 0) { // present timing, MoltenVK
+        snapshot.lastPresentTime
+            = _clockDomains.PresentToHost(_softwareEvenOddCtx.mostRecentPresentFinish);
+    } else if (std::optional<VblankClock::Sample> vblank = _vblankCtx.clock.Read()) {
+        snapshot.lastPresentTime = vblank->time;
+    }
+    observeSurfaceCounter(snapshot.surfaceCounter, snapshot.captureTime);
+}
+
+uint64_t Tetrium::getRefreshPeriodNanoSeconds()
+{
+    switch (_tetraMode) {
+    case TetraMode::kEvenOddSoftwareSync:
+#if __linux__
+        return _presentWaitCtx.refreshPeriodNanoSeconds.load(std::memory_order_relaxed);
+#else
+        return _softwareEvenOddCtx.nanoSecondsPerFrame;
+#endif // __linux__
+    case TetraMode::kEvenOddHardwareSync:
+        // refresh rate is in mHz
+        return _mainProjectorDisplay.refreshrate == 0
+                   ? 0
+                   : 1'000'000'000'000ull / _mainProjectorDisplay.refreshrate;
+    case TetraMode::kEvenOddVirtualSync:
+        return _virtualDisplay.GetRefreshPeriodNanoSeconds();
+    default:
+        return 0;
+    }
+}
+
+void Tetrium::observeSurfaceCounter(uint64_t counter, std::chrono::steady_clock::time_point time)
+{
+    auto& ctx = _parityPredictionCtx;
+    uint64_t refreshPeriod = getRefreshPeriodNanoSeconds();
+    _framePacer.SetNominalPeriod(refreshPeriod);
+    std::optional<VblankClock::Sample> vblank = _vblankCtx.clock.Read();
+    if (vblank.has_value()) {
+        _framePacer.ObserveVblank(vblank->counter, vblank->time);
+    } else if (counter != ctx.lastObservedCounter
+               && time - ctx.lastObservedTime < std::chrono::nanoseconds(refreshPeriod / 8)) {
+        // the vblank happened in between the samples, close ones pin it down well enough
+        _framePacer.ObserveVblank(
+            counter, ctx.lastObservedTime + (time - ctx.lastObservedTime) / 2
+        );
+    }
+    if (counter != ctx.lastObservedCounter) {
+        // the counter ticked some time between the previous sample and this one
+        ctx.vblankLowerBound = ctx.lastObservedTime;
+        ctx.lastObservedCounter = counter;
+    }
+    ctx.lastObservedTime = time;
+}
+
+std::optional<ColorSpace> Tetrium::predictPresentedColorSpace()
+{
+    auto& ctx = _parityPredictionCtx;
+    auto now = std::chrono::steady_clock::now();
+    uint64_t counter = getSurfaceCounterValue();
+    observeSurfaceCounter(counter, now);
+    std::optional<VblankClock::Sample> vblank = _vblankCtx.clock.Read();
+    if (vblank.has_value() && vblank->counter == counter) {
+        ctx.vblankLowerBound = vblank->time; // exact, from the display event
+    }
+
+    uint64_t refreshPeriod = getRefreshPeriodNanoSeconds();
+    if (refreshPeriod == 0 || ctx.vblankLowerBound.time_since_epoch().count() == 0) {
+        return std::nullopt;
+    }
+
+    // the last vblank happened at most this long ago, the next one is at least
+    // `refreshPeriod - sinceVblank` away
+    int64_t sinceVblank
+        = std::chrono::duration_cast<std::chrono::nanoseconds>(now - ctx.vblankLowerBound).count();
+    int64_t untilNextVblank = static_cast<int64_t>(refreshPeriod) - sinceVblank;
+    int64_t required = static_cast<int64_t>(ctx.predictionToSampleNanoSeconds)
+                       + ctx.safetyMarginNanoSeconds;
+    if (untilNextVblank <= required) {
+        return std::nullopt;
+    }
+
+    bool isEven = counter % 2 == 0;
+    if (_flipEvenOdd) {
+        isEven = !isEven;
+    }
+    return isEven ? RGB : OCV;
+}
+
+namespace
+{
+// calibrated submit guards, one line per display mode, in the working directory
+const char* EVEN_ODD_CALIBRATION_FILE = "even_odd_calibration.txt";
+} // namespace
+
+std::string Tetrium::getEvenOddCalibrationKey()
+{
+    const char* mode = "";
+    VkExtent2D extent = _swapChain.extent;
+    uint64_t refreshPeriod = getRefreshPeriodNanoSeconds();
+    switch (_tetraMode) {
+    case TetraMode::kEvenOddHardwareSync:
+        mode = "hardware";
+        extent = _mainProjectorDisplay.extent;
+        break;
+    case TetraMode::kEvenOddSoftwareSync:
+        mode = "software";
+        // the display mode's, the live estimate keeps getting refined & would change the key
+        refreshPeriod = _softwareEvenOddCtx.nanoSecondsPerFrame;
+        break;
+    case TetraMode::kEvenOddVirtualSync:
+        mode = "virtual";
+        break;
+    default:
+        break;
+    }
+    double refreshRate = 1e9 / refreshPeriod;
+    return fmt::format("{} {}x{} {:.1f}Hz", mode, extent.width, extent.height, refreshRate);
+}
+
+void Tetrium::startEvenOddCalibration()
+{
+    auto& ctx = _evenOddCalibrationCtx;
+    uint64_t refreshPeriod = getRefreshPeriodNanoSeconds();
+    if (refreshPeriod == 0) {
+        return;
+    }
+    if (!ctx.calibrator.IsRunning()) {
+        ctx.guardBeforeNanoSeconds = _vblankCtx.submitGuardNanoSeconds;
+    }
+    _vblankCtx.pacedSubmission = true; // the guard does nothing otherwise
+    ctx.calibrator.Start(refreshPeriod, EvenOddCalibrator::Config{});
+    _vblankCtx.submitGuardNanoSeconds = ctx.calibrator.GetOffset();
+}
+
+void Tetrium::cancelEvenOddCalibration()
+{
+    auto& ctx = _evenOddCalibrationCtx;
+    if (ctx.calibrator.IsRunning()) {
+        ctx.calibrator.Cancel();
+        _vblankCtx.submitGuardNanoSeconds = ctx.guardBeforeNanoSeconds;
+    }
+}
+
+void Tetrium::updateEvenOddCalibration()
+{
+    auto& ctx = _evenOddCalibrationCtx;
+    if (_tetraMode != TetraMode::kEvenOddHardwareSync
+        && _tetraMode != TetraMode::kEvenOddSoftwareSync
+        && _tetraMode != TetraMode::kEvenOddVirtualSync) {
+        return;
+    }
+    if (!ctx.loaded) { // apply the display mode's last calibration, once it's known
+        if (getRefreshPeriodNanoSeconds() == 0) {
+            return;
+        }
+        ctx.loaded = true;
+        ctx.key = getEvenOddCalibrationKey();
+        ctx.result = EvenOddCalibrator::Load(EVEN_ODD_CALIBRATION_FILE, ctx.key);
+        if (ctx.result.has_value()) {
+            _vblankCtx.pacedSubmission = true;
+            _vblankCtx.submitGuardNanoSeconds = ctx.result->offsetNanoSeconds;
+            INFO(
+                "Loaded even-odd calibration for {}: {}ns submit guard",
+                ctx.key,
+                ctx.result->offsetNanoSeconds
+            );
+        }
+    }
+
+    EvenOddCalibrator& calibrator = ctx.calibrator;
+    if (!calibrator.IsRunning()) {
+        return;
+    }
+    const FrameJournal::FrameRecord& record = _frameJournal.CurrentFrame();
+    if (record.presentedColorSpace.has_value()) { // otherwise no parity got sampled
+        calibrator.OnFrame(record.parityMiss);
+    }
+    if (calibrator.IsRunning()) {
+        _vblankCtx.submitGuardNanoSeconds = calibrator.GetOffset();
+        return;
+    }
+
+    ctx.key = getEvenOddCalibrationKey();
+    ctx.result = calibrator.GetResult();
+    _vblankCtx.submitGuardNanoSeconds = ctx.result->offsetNanoSeconds;
+    INFO(
+        "Calibrated even-odd for {}: {}ns submit guard, {:.2f}% drops, {:.1f}% confidence",
+        ctx.key,
+        ctx.result->offsetNanoSeconds,
+        ctx.result->dropRate * 100,
+        ctx.result->confidence * 100
+    );
+    if (!EvenOddCalibrator::Save(EVEN_ODD_CALIBRATION_FILE, ctx.key, ctx.result.value())) {
+        WARN("Failed to save the even-odd calibration to {}", EVEN_ODD_CALIBRATION_FILE);
+    }
+}
@@ -55,6 +55,7 @@ void drawFootNote()
 void Tetrium::drawImGui(ColorSpace colorSpace)
 {
     if (!_wantToDrawImGui) {
+        _staticFrameCtx.liveWidgetShown = false;
         return;
     }
     ImGui::SetCurrentContext(_imguiCtx.ctxImGui[colorSpace]);
@@ -63,11 +64,12 @@ void Tetrium::drawImGui(ColorSpace colorSpace)
     // ---------- Prologue ----------
     // note that drawImGui is called twice per tick for RGB and OCV space,
     // so we need different profiler ID for them.
-    const char* profileId = colorSpace == ColorSpace::RGB ? "ImGui Draw RGB" : "ImGui Draw OCV";
-    PROFILE_SCOPE(&_profiler, profileId);
+    static constexpr Profiler::ScopeDescriptor SCOPES[ColorSpace::ColorSpaceSize]
+        = {{"ImGui Draw RGB", __FILE__, __LINE__}, {"ImGui Draw OCV", __FILE__, __LINE__}};
+    PROFILE_SCOPE_DESCRIPTOR(&_profiler, SCOPES[colorSpace]);
 
     ImGui_ImplVulkan_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
+    newImGuiPlatformFrame();
     ImGui::NewFrame();
 
     // imgui is associated with the glfw window to handle inputs,
@@ -95,9 +97,12 @@ void Tetrium::drawImGui(ColorSpace colorSpace)
     }
     Tetrium_GUI::drawFootNote();
 
+    // whether any shown widget draws content that changes every tick
+    bool liveWidgetShown = false;
     if (ImGui::Begin(DEFAULTS::Engine::APPLICATION_NAME)) {
         if (ImGui::BeginTabBar("Engine Tab")) {
             if (ImGui::BeginTabItem((const char*)u8"🏠General")) {
+                liveWidgetShown = true;
                 ImGui::ShowDemoWindow();
                 ImGui::SeparatorText("📹Camera");
                 {
@@ -137,6 +142,7 @@ void Tetrium::drawImGui(ColorSpace colorSpace)
             }
 
             if (ImGui::BeginTabItem("🚀Performance")) {
+                liveWidgetShown = true;
                 _widgetPerfPlot.Draw(this, colorSpace);
                 ImGui::EndTabItem();
             }
@@ -147,6 +153,7 @@ void Tetrium::drawImGui(ColorSpace colorSpace)
             }
 
             if (ImGui::BeginTabItem("🛸Even-Odd")) {
+                liveWidgetShown = true;
                 _widgetEvenOdd.Draw(this, colorSpace);
                 ImGui::EndTabItem();
             }
@@ -167,4 +174,5 @@ void Tetrium::drawImGui(ColorSpace colorSpace)
 
     ImGui::End();
     ImGui::Render();
+    _staticFrameCtx.liveWidgetShown = liveWidgetShown;
 }
@@ -0,0 +1,51 @@
+// Headless benchmarking implementations
+#include "Tetrium.h"
+
+void Tetrium::runHeadless()
+{
+    INFO("Running {} headless ticks...", _headlessCtx.numTicks);
+    auto begin = std::chrono::steady_clock::now();
+    while (_numTicks < _headlessCtx.numTicks) {
+        Tick();
+        accumulateProfilerSummary(*_lastProfilerData);
+    }
+    // frames may still be in flight
+    vkDeviceWaitIdle(_device->logicalDevice);
+    double seconds
+        = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    INFO(
+        "Headless run finished: {} ticks in {:.3f} s, {:.3f} ms/tick",
+        _numTicks,
+        seconds,
+        _numTicks == 0 ? 0 : seconds * 1000 / _numTicks
+    );
+    printProfilerSummary();
+}
+
+void Tetrium::accumulateProfilerSummary(const std::vector<Profiler::Entry>& profile)
+{
+    for (const Profiler::Entry& entry : profile) {
+        double ms = std::chrono::duration<double, std::chrono::milliseconds::period>(
+                        entry.end - entry.begin
+        )
+                        .count();
+        ProfilerSummaryEntry& summary = _headlessCtx.summary[entry.name];
+        summary.totalMilliseconds += ms;
+        summary.maxMilliseconds = std::max(summary.maxMilliseconds, ms);
+        summary.count++;
+    }
+}
+
+void Tetrium::printProfilerSummary()
+{
+    INFO("{:<40} {:>10} {:>10} {:>10}", "Profiler Entry", "Mean(ms)", "Max(ms)", "Count");
+    for (const auto& [name, summary] : _headlessCtx.summary) {
+        INFO(
+            "{:<40} {:>10.3f} {:>10.3f} {:>10}",
+            name,
+            summary.totalMilliseconds / summary.count,
+            summary.maxMilliseconds,
+            summary.count
+        );
+    }
+}
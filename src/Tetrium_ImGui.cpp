@@ -1,4 +1,6 @@
 // ImGui initialization and resource management
+#include <string_view>
+
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_vulkan.h"
 #include "imgui.h"
@@ -16,6 +18,9 @@ static ImPlotContext* ctxImPlot[ColorSpace::ColorSpaceSize] = {};
 
 namespace GLFW
 {
+// number of input events forwarded to imgui
+static uint64_t numInputEvents = 0;
+
 struct
 {
     GLFWwindowfocusfun WindowFocus = nullptr;
@@ -30,6 +35,7 @@ struct
 
 void ImGuiCustomWindowFocusCallback(GLFWwindow* window, int focused)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -42,6 +48,7 @@ void ImGuiCustomWindowFocusCallback(GLFWwindow* window, int focused)
 
 void ImGuiCustomCursorEnterCallback(GLFWwindow* window, int entered)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -54,6 +61,7 @@ void ImGuiCustomCursorEnterCallback(GLFWwindow* window, int entered)
 
 void ImGuiCustomCursorPosCallback(GLFWwindow* window, double xpos, double ypos)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -66,6 +74,7 @@ void ImGuiCustomCursorPosCallback(GLFWwindow* window, double xpos, double ypos)
 
 void ImGuiCustomMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -78,6 +87,7 @@ void ImGuiCustomMouseButtonCallback(GLFWwindow* window, int button, int action,
 
 void ImGuiCustomScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -90,6 +100,7 @@ void ImGuiCustomScrollCallback(GLFWwindow* window, double xoffset, double yoffse
 
 void ImGuiCustomKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -102,6 +113,7 @@ void ImGuiCustomKeyCallback(GLFWwindow* window, int key, int scancode, int actio
 
 void ImGuiCustomCharCallback(GLFWwindow* window, unsigned int c)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -114,6 +126,7 @@ void ImGuiCustomCharCallback(GLFWwindow* window, unsigned int c)
 
 void ImGuiCustomMonitorCallback(GLFWmonitor* monitor, int event)
 {
+    numInputEvents++;
     for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
         ImGui::SetCurrentContext(ctxImGui[i]);
         ImPlot::SetCurrentContext(ctxImPlot[i]);
@@ -124,14 +137,339 @@ void ImGuiCustomMonitorCallback(GLFWmonitor* monitor, int event)
         prevCallbacks.Monitor(monitor, event);
 }
 
+// deferred callbacks only record the event into `eventSink`, to be replayed on another thread
+// with `DispatchEvent()`
+static std::function<void(const WindowEvent&)> eventSink;
+
+// the modifiers held, as imgui's glfw backend reads them; main thread only
+int QueryHeldMods(GLFWwindow* window)
+{
+    auto held = [window](int left, int right) {
+        return glfwGetKey(window, left) == GLFW_PRESS || glfwGetKey(window, right) == GLFW_PRESS;
+    };
+    int mods = 0;
+    mods |= held(GLFW_KEY_LEFT_CONTROL, GLFW_KEY_RIGHT_CONTROL) ? GLFW_MOD_CONTROL : 0;
+    mods |= held(GLFW_KEY_LEFT_SHIFT, GLFW_KEY_RIGHT_SHIFT) ? GLFW_MOD_SHIFT : 0;
+    mods |= held(GLFW_KEY_LEFT_ALT, GLFW_KEY_RIGHT_ALT) ? GLFW_MOD_ALT : 0;
+    mods |= held(GLFW_KEY_LEFT_SUPER, GLFW_KEY_RIGHT_SUPER) ? GLFW_MOD_SUPER : 0;
+    return mods;
+}
+
+// glfw reports keys by their US layout position, imgui's glfw backend maps printable keys
+// back to what the layout prints on them so that lettered shortcuts work; main thread only
+int TranslateUntranslatedKey(int key, int scancode)
+{
+    if (key >= GLFW_KEY_KP_0 && key <= GLFW_KEY_KP_EQUAL) {
+        return key;
+    }
+    GLFWerrorfun prevErrorCallback = glfwSetErrorCallback(nullptr);
+    const char* keyName = glfwGetKeyName(key, scancode);
+    glfwSetErrorCallback(prevErrorCallback);
+    if (keyName == nullptr || keyName[0] == '\0' || keyName[1] != '\0') {
+        return key;
+    }
+    const std::string_view charNames = "`-=[]\\,;\'./";
+    const int charKeys[] = {
+        GLFW_KEY_GRAVE_ACCENT,
+        GLFW_KEY_MINUS,
+        GLFW_KEY_EQUAL,
+        GLFW_KEY_LEFT_BRACKET,
+        GLFW_KEY_RIGHT_BRACKET,
+        GLFW_KEY_BACKSLASH,
+        GLFW_KEY_COMMA,
+        GLFW_KEY_SEMICOLON,
+        GLFW_KEY_APOSTROPHE,
+        GLFW_KEY_PERIOD,
+        GLFW_KEY_SLASH
+    };
+    char c = keyName[0];
+    if (c >= '0' && c <= '9') {
+        return GLFW_KEY_0 + (c - '0');
+    } else if (c >= 'A' && c <= 'Z') {
+        return GLFW_KEY_A + (c - 'A');
+    } else if (c >= 'a' && c <= 'z') {
+        return GLFW_KEY_A + (c - 'a');
+    } else if (size_t i = charNames.find(c); i != std::string_view::npos) {
+        return charKeys[i];
+    }
+    return key;
+}
+
+// as imgui's glfw backend maps them
+ImGuiKey KeyToImGuiKey(int key)
+{
+    if (key >= GLFW_KEY_0 && key <= GLFW_KEY_9) {
+        return static_cast<ImGuiKey>(ImGuiKey_0 + (key - GLFW_KEY_0));
+    }
+    if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z) {
+        return static_cast<ImGuiKey>(ImGuiKey_A + (key - GLFW_KEY_A));
+    }
+    if (key >= GLFW_KEY_F1 && key <= GLFW_KEY_F12) {
+        return static_cast<ImGuiKey>(ImGuiKey_F1 + (key - GLFW_KEY_F1));
+    }
+    if (key >= GLFW_KEY_KP_0 && key <= GLFW_KEY_KP_9) {
+        return static_cast<ImGuiKey>(ImGuiKey_Keypad0 + (key - GLFW_KEY_KP_0));
+    }
+    switch (key) {
+    case GLFW_KEY_TAB:
+        return ImGuiKey_Tab;
+    case GLFW_KEY_LEFT:
+        return ImGuiKey_LeftArrow;
+    case GLFW_KEY_RIGHT:
+        return ImGuiKey_RightArrow;
+    case GLFW_KEY_UP:
+        return ImGuiKey_UpArrow;
+    case GLFW_KEY_DOWN:
+        return ImGuiKey_DownArrow;
+    case GLFW_KEY_PAGE_UP:
+        return ImGuiKey_PageUp;
+    case GLFW_KEY_PAGE_DOWN:
+        return ImGuiKey_PageDown;
+    case GLFW_KEY_HOME:
+        return ImGuiKey_Home;
+    case GLFW_KEY_END:
+        return ImGuiKey_End;
+    case GLFW_KEY_INSERT:
+        return ImGuiKey_Insert;
+    case GLFW_KEY_DELETE:
+        return ImGuiKey_Delete;
+    case GLFW_KEY_BACKSPACE:
+        return ImGuiKey_Backspace;
+    case GLFW_KEY_SPACE:
+        return ImGuiKey_Space;
+    case GLFW_KEY_ENTER:
+        return ImGuiKey_Enter;
+    case GLFW_KEY_ESCAPE:
+        return ImGuiKey_Escape;
+    case GLFW_KEY_APOSTROPHE:
+        return ImGuiKey_Apostrophe;
+    case GLFW_KEY_COMMA:
+        return ImGuiKey_Comma;
+    case GLFW_KEY_MINUS:
+        return ImGuiKey_Minus;
+    case GLFW_KEY_PERIOD:
+        return ImGuiKey_Period;
+    case GLFW_KEY_SLASH:
+        return ImGuiKey_Slash;
+    case GLFW_KEY_SEMICOLON:
+        return ImGuiKey_Semicolon;
+    case GLFW_KEY_EQUAL:
+        return ImGuiKey_Equal;
+    case GLFW_KEY_LEFT_BRACKET:
+        return ImGuiKey_LeftBracket;
+    case GLFW_KEY_BACKSLASH:
+        return ImGuiKey_Backslash;
+    case GLFW_KEY_RIGHT_BRACKET:
+        return ImGuiKey_RightBracket;
+    case GLFW_KEY_GRAVE_ACCENT:
+        return ImGuiKey_GraveAccent;
+    case GLFW_KEY_CAPS_LOCK:
+        return ImGuiKey_CapsLock;
+    case GLFW_KEY_SCROLL_LOCK:
+        return ImGuiKey_ScrollLock;
+    case GLFW_KEY_NUM_LOCK:
+        return ImGuiKey_NumLock;
+    case GLFW_KEY_PRINT_SCREEN:
+        return ImGuiKey_PrintScreen;
+    case GLFW_KEY_PAUSE:
+        return ImGuiKey_Pause;
+    case GLFW_KEY_KP_DECIMAL:
+        return ImGuiKey_KeypadDecimal;
+    case GLFW_KEY_KP_DIVIDE:
+        return ImGuiKey_KeypadDivide;
+    case GLFW_KEY_KP_MULTIPLY:
+        return ImGuiKey_KeypadMultiply;
+    case GLFW_KEY_KP_SUBTRACT:
+        return ImGuiKey_KeypadSubtract;
+    case GLFW_KEY_KP_ADD:
+        return ImGuiKey_KeypadAdd;
+    case GLFW_KEY_KP_ENTER:
+        return ImGuiKey_KeypadEnter;
+    case GLFW_KEY_KP_EQUAL:
+        return ImGuiKey_KeypadEqual;
+    case GLFW_KEY_LEFT_SHIFT:
+        return ImGuiKey_LeftShift;
+    case GLFW_KEY_LEFT_CONTROL:
+        return ImGuiKey_LeftCtrl;
+    case GLFW_KEY_LEFT_ALT:
+        return ImGuiKey_LeftAlt;
+    case GLFW_KEY_LEFT_SUPER:
+        return ImGuiKey_LeftSuper;
+    case GLFW_KEY_RIGHT_SHIFT:
+        return ImGuiKey_RightShift;
+    case GLFW_KEY_RIGHT_CONTROL:
+        return ImGuiKey_RightCtrl;
+    case GLFW_KEY_RIGHT_ALT:
+        return ImGuiKey_RightAlt;
+    case GLFW_KEY_RIGHT_SUPER:
+        return ImGuiKey_RightSuper;
+    case GLFW_KEY_MENU:
+        return ImGuiKey_Menu;
+    default:
+        return ImGuiKey_None;
+    }
+}
+
+// imgui's glfw backend adds these ahead of every mouse button & key event
+void AddHeldModsEvents(ImGuiIO& io, int heldMods)
+{
+    io.AddKeyEvent(ImGuiMod_Ctrl, heldMods & GLFW_MOD_CONTROL);
+    io.AddKeyEvent(ImGuiMod_Shift, heldMods & GLFW_MOD_SHIFT);
+    io.AddKeyEvent(ImGuiMod_Alt, heldMods & GLFW_MOD_ALT);
+    io.AddKeyEvent(ImGuiMod_Super, heldMods & GLFW_MOD_SUPER);
+}
+
+void ReplayMouseButton(GLFWwindow* window, const WindowEvent& e)
+{
+    int button = e.i[0], action = e.i[1], mods = e.i[2];
+    numInputEvents++;
+    for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
+        ImGui::SetCurrentContext(ctxImGui[i]);
+        ImPlot::SetCurrentContext(ctxImPlot[i]);
+        ImGuiIO& io = ImGui::GetIO();
+        AddHeldModsEvents(io, e.heldMods);
+        if (button >= 0 && button < ImGuiMouseButton_COUNT) {
+            io.AddMouseButtonEvent(button, action == GLFW_PRESS);
+        }
+    }
+
+    if (prevCallbacks.MouseButton)
+        prevCallbacks.MouseButton(window, button, action, mods);
+}
+
+void ReplayKey(GLFWwindow* window, const WindowEvent& e)
+{
+    int key = e.i[0], scancode = e.i[1], action = e.i[2], mods = e.i[3];
+    numInputEvents++;
+    if (action == GLFW_PRESS || action == GLFW_RELEASE) { // imgui repeats keys on its own
+        ImGuiKey imguiKey = KeyToImGuiKey(e.translatedKey);
+        for (int i = 0; i < ColorSpace::ColorSpaceSize; ++i) {
+            ImGui::SetCurrentContext(ctxImGui[i]);
+            ImPlot::SetCurrentContext(ctxImPlot[i]);
+            ImGuiIO& io = ImGui::GetIO();
+            AddHeldModsEvents(io, e.heldMods);
+            io.AddKeyEvent(imguiKey, action == GLFW_PRESS);
+            io.SetKeyEventNativeData(imguiKey, e.translatedKey, scancode);
+        }
+    }
+
+    if (prevCallbacks.Key)
+        prevCallbacks.Key(window, key, scancode, action, mods);
+}
+
+void DeferredWindowFocusCallback(GLFWwindow* window, int focused)
+{
+    eventSink(WindowEvent{.type = WindowEvent::Type::kWindowFocus, .i = {focused}});
+}
+
+void DeferredCursorEnterCallback(GLFWwindow* window, int entered)
+{
+    eventSink(WindowEvent{.type = WindowEvent::Type::kCursorEnter, .i = {entered}});
+}
+
+void DeferredCursorPosCallback(GLFWwindow* window, double xpos, double ypos)
+{
+    eventSink(WindowEvent{.type = WindowEvent::Type::kCursorPos, .d = {xpos, ypos}});
+}
+
+void DeferredMouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+    eventSink(WindowEvent{
+        .type = WindowEvent::Type::kMouseButton,
+        .i = {button, action, mods},
+        .heldMods = QueryHeldMods(window)
+    });
+}
+
+void DeferredScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    eventSink(WindowEvent{.type = WindowEvent::Type::kScroll, .d = {xoffset, yoffset}});
+}
+
+void DeferredKeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    eventSink(WindowEvent{
+        .type = WindowEvent::Type::kKey,
+        .i = {key, scancode, action, mods},
+        .heldMods = QueryHeldMods(window),
+        .translatedKey = TranslateUntranslatedKey(key, scancode)
+    });
+}
+
+void DeferredCharCallback(GLFWwindow* window, unsigned int c)
+{
+    eventSink(WindowEvent{.type = WindowEvent::Type::kChar, .i = {static_cast<int>(c)}});
+}
+
+void DeferredMonitorCallback(GLFWmonitor* monitor, int event)
+{
+    eventSink(
+        WindowEvent{.type = WindowEvent::Type::kMonitor, .i = {event}, .monitor = monitor}
+    );
+}
+
+// replay a deferred event on the calling thread, as if glfw invoked the custom callback;
+// never calls into glfw, mouse buttons & keys go to imgui without its glfw backend
+void DispatchEvent(GLFWwindow* window, const WindowEvent& e)
+{
+    switch (e.type) {
+    case WindowEvent::Type::kWindowFocus:
+        ImGuiCustomWindowFocusCallback(window, e.i[0]);
+        break;
+    case WindowEvent::Type::kCursorEnter:
+        ImGuiCustomCursorEnterCallback(window, e.i[0]);
+        break;
+    case WindowEvent::Type::kCursorPos:
+        ImGuiCustomCursorPosCallback(window, e.d[0], e.d[1]);
+        break;
+    case WindowEvent::Type::kMouseButton:
+        ReplayMouseButton(window, e);
+        break;
+    case WindowEvent::Type::kScroll:
+        ImGuiCustomScrollCallback(window, e.d[0], e.d[1]);
+        break;
+    case WindowEvent::Type::kKey:
+        ReplayKey(window, e);
+        break;
+    case WindowEvent::Type::kChar:
+        ImGuiCustomCharCallback(window, static_cast<unsigned int>(e.i[0]));
+        break;
+    case WindowEvent::Type::kMonitor:
+        ImGuiCustomMonitorCallback(e.monitor, e.i[0]);
+        break;
+    }
+}
+
 } // namespace GLFW
 
 // Set up custom callback functions that invokes on both RGB
 // and OCV imgui contexts; Naively binding all callbacks through
 // GLFW doesn't work, as the callbacks do not handle context switching.
-void setupCustomCallbacks(GLFWwindow* window)
+//
+// With an EVENTSINK, glfw's callbacks only hand events over to it;
+// the custom callbacks run once the events get passed to `GLFW::DispatchEvent()`.
+void setupCustomCallbacks(
+    GLFWwindow* window,
+    std::function<void(const WindowEvent&)> eventSink = nullptr
+)
 {
     // Store previous callbacks and set new ones
+    if (eventSink) {
+        GLFW::eventSink = std::move(eventSink);
+        GLFW::prevCallbacks.WindowFocus
+            = glfwSetWindowFocusCallback(window, GLFW::DeferredWindowFocusCallback);
+        GLFW::prevCallbacks.CursorEnter
+            = glfwSetCursorEnterCallback(window, GLFW::DeferredCursorEnterCallback);
+        GLFW::prevCallbacks.CursorPos
+            = glfwSetCursorPosCallback(window, GLFW::DeferredCursorPosCallback);
+        GLFW::prevCallbacks.MouseButton
+            = glfwSetMouseButtonCallback(window, GLFW::DeferredMouseButtonCallback);
+        GLFW::prevCallbacks.Scroll = glfwSetScrollCallback(window, GLFW::DeferredScrollCallback);
+        GLFW::prevCallbacks.Key = glfwSetKeyCallback(window, GLFW::DeferredKeyCallback);
+        GLFW::prevCallbacks.Char = glfwSetCharCallback(window, GLFW::DeferredCharCallback);
+        GLFW::prevCallbacks.Monitor = glfwSetMonitorCallback(GLFW::DeferredMonitorCallback);
+        return;
+    }
     GLFW::prevCallbacks.WindowFocus
         = glfwSetWindowFocusCallback(window, GLFW::ImGuiCustomWindowFocusCallback);
     GLFW::prevCallbacks.CursorEnter
@@ -336,6 +674,9 @@ void initFonts()
 
 void Tetrium::reinitImGuiFrameBuffers(Tetrium::ImGuiRenderContexts& ctx)
 {
+    if (ctx.mergedIntoMainPass) { // renders into the virtual frame buffers directly
+        return;
+    }
     for (auto framebuffer : {&ctx.frameBuffers[RGB], &ctx.frameBuffers[OCV]}) {
         for (auto fb : *framebuffer) {
             vkDestroyFramebuffer(_device->logicalDevice, fb, nullptr);
@@ -359,7 +700,9 @@ void Tetrium::destroyImGuiContext(Tetrium::ImGuiRenderContexts& ctx)
     // not a big problem for now since we only shut down at very end, but 
     // it leads to ugly validation errors
     ImGui_ImplVulkan_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
+    if (_window) {
+        ImGui_ImplGlfw_Shutdown();
+    }
     ImPlot::DestroyContext();
     ImGui::DestroyContext();
     for (ColorSpace cs : {RGB, OCV}) {
@@ -374,31 +717,33 @@ void Tetrium::destroyImGuiContext(Tetrium::ImGuiRenderContexts& ctx)
 
 void Tetrium::initImGuiRenderContext(Tetrium::ImGuiRenderContexts& ctx)
 {
-    // create render pass
-    VkImageLayout imguiInitialLayout, imguiFinalLayout;
-    imguiInitialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-    imguiFinalLayout
-        = _tetraMode == TetraMode::kDualProjector
-              ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR       // dual project's two passes directly present
-              : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; // virtual fb to be finally transferred to
-                                                      // swapchain
-    ctx.renderPass = Tetrium_ImGui::createRenderPass(
-        _device->Get(), _swapChain.imageFormat, imguiInitialLayout, imguiFinalLayout
-    );
-
     ctx.descriptorPool = Tetrium_ImGui::createDescriptorPool(
         DEFAULTS::ImGui::TEXTURE_DESCRIPTOR_POOL_SIZE, _device->Get()
     );
-    Tetrium_ImGui::InitializeFrameBuffer(
-        _device->Get(),
-        _swapChain.extent,
-        ctx.renderPass,
-        _swapChain.numImages,
-        _renderContexts[RGB].virtualFrameBuffer.imageView,
-        _renderContexts[OCV].virtualFrameBuffer.imageView,
-        ctx.frameBuffers[RGB],
-        ctx.frameBuffers[OCV]
-    );
+
+    if (!ctx.mergedIntoMainPass) { // create render pass
+        VkImageLayout imguiInitialLayout, imguiFinalLayout;
+        imguiInitialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        imguiFinalLayout
+            = _tetraMode == TetraMode::kDualProjector
+                  ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR // dual project's two passes directly present
+                  : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL; // virtual fb to be finally
+                                                          // transferred to swapchain
+        ctx.renderPass = Tetrium_ImGui::createRenderPass(
+            _device->Get(), _swapChain.imageFormat, imguiInitialLayout, imguiFinalLayout
+        );
+
+        Tetrium_ImGui::InitializeFrameBuffer(
+            _device->Get(),
+            _swapChain.extent,
+            ctx.renderPass,
+            _swapChain.numImages,
+            _renderContexts[RGB].virtualFrameBuffer.imageView,
+            _renderContexts[OCV].virtualFrameBuffer.imageView,
+            ctx.frameBuffers[RGB],
+            ctx.frameBuffers[OCV]
+        );
+    }
 
     ImGui_ImplVulkan_InitInfo initInfo = {};
     initInfo.Instance = _instance;
@@ -412,7 +757,13 @@ void Tetrium::initImGuiRenderContext(Tetrium::ImGuiRenderContexts& ctx)
     initInfo.MinImageCount = 2;
     initInfo.ImageCount = _swapChain.numImages;
     initInfo.CheckVkResultFn = nullptr;
-    initInfo.RenderPass = ctx.renderPass;
+    if (ctx.mergedIntoMainPass) { // main render passes of both color spaces are compatible
+        initInfo.RenderPass = _renderContexts[RGB].renderPass;
+        initInfo.Subpass = 1;
+    } else {
+        initInfo.RenderPass = ctx.renderPass;
+        initInfo.Subpass = 0;
+    }
 
     IMGUI_CHECKVERSION();
 
@@ -423,7 +774,9 @@ void Tetrium::initImGuiRenderContext(Tetrium::ImGuiRenderContexts& ctx)
         ImGui::SetCurrentContext(ctx.ctxImGui[cs]);
         ImPlot::SetCurrentContext(ctx.ctxImPlot[cs]);
 
-        ImGui_ImplGlfw_InitForVulkan(_window, false);
+        if (_window) { // headless imgui takes no input
+            ImGui_ImplGlfw_InitForVulkan(_window, false);
+        }
         ImGui_ImplVulkan_Init(&initInfo);
 
         ImGuiIO& io = ImGui::GetIO();
@@ -439,7 +792,16 @@ void Tetrium::initImGuiRenderContext(Tetrium::ImGuiRenderContexts& ctx)
         Tetrium_ImGui::ctxImPlot[cs] = ctx.ctxImPlot[cs];
     }
 
-    Tetrium_ImGui::setupCustomCallbacks(_window);
+    if (_window && _renderThreadCtx.enabled) { // events are polled on the main thread,
+                                               // and replayed on the render thread
+        Tetrium_ImGui::setupCustomCallbacks(_window, [this](const WindowEvent& event) {
+            if (!_renderThreadCtx.windowEvents.TryPush(event)) {
+                _renderThreadCtx.numDroppedWindowEvents++;
+            }
+        });
+    } else if (_window) {
+        Tetrium_ImGui::setupCustomCallbacks(_window);
+    }
     DEBUG("imgui context initialized");
 }
 
@@ -451,10 +813,6 @@ void Tetrium::recordImGuiDrawCommandBuffer(
     int swapChainImageIndex
 )
 {
-    // assuming drawImGui() has been invoked for both colorSpace
-    ImGui::SetCurrentContext(_imguiCtx.ctxImGui[colorSpace]);
-    ImPlot::SetCurrentContext(_imguiCtx.ctxImPlot[colorSpace]);
-
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassInfo.renderPass = ctx.renderPass;
@@ -465,13 +823,22 @@ void Tetrium::recordImGuiDrawCommandBuffer(
     renderPassInfo.pClearValues = nullptr;
 
     vkCmdBeginRenderPass(cb, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    recordImGuiDrawData(colorSpace, cb);
+    vkCmdEndRenderPass(cb);
+}
+
+void Tetrium::recordImGuiDrawData(ColorSpace colorSpace, vk::CommandBuffer cb)
+{
+    // assuming drawImGui() has been invoked for both colorSpace
+    // imgui's current context is a global, so this must not run on more than one thread at once
+    ImGui::SetCurrentContext(_imguiCtx.ctxImGui[colorSpace]);
+    ImPlot::SetCurrentContext(_imguiCtx.ctxImPlot[colorSpace]);
 
     ImDrawData* drawData = ImGui::GetDrawData();
     if (drawData == nullptr) {
         FATAL("Draw data is null!");
     }
     ImGui_ImplVulkan_RenderDrawData(drawData, cb);
-    vkCmdEndRenderPass(cb);
 }
 
 const ImGuiTexture& Tetrium::getOrLoadImGuiTexture(
@@ -496,10 +863,47 @@ const ImGuiTexture& Tetrium::getOrLoadImGuiTexture(
     return res.first->second;
 }
 
+uint64_t Tetrium::getNumImGuiInputEvents() { return Tetrium_ImGui::GLFW::numInputEvents; }
+
+void Tetrium::dispatchWindowEvents()
+{
+    while (std::optional<WindowEvent> event = _renderThreadCtx.windowEvents.TryPop()) {
+        Tetrium_ImGui::GLFW::DispatchEvent(_window, event.value());
+    }
+}
+
+void Tetrium::newImGuiPlatformFrame()
+{
+    if (_window && !_renderThreadCtx.enabled) {
+        ImGui_ImplGlfw_NewFrame();
+        return;
+    }
+    // glfw's backend queries the window, which only the main thread may do;
+    // fill in what it would have from the window size published by the main thread.
+    // Inputs arrive through the replayed callbacks.
+    ImGuiIO& io = ImGui::GetIO();
+    int width, height, fbWidth, fbHeight;
+    getWindowSize(width, height);
+    getFramebufferSize(fbWidth, fbHeight);
+    io.DisplaySize = {static_cast<float>(width), static_cast<float>(height)};
+    if (width > 0 && height > 0) {
+        io.DisplayFramebufferScale
+            = {static_cast<float>(fbWidth) / width, static_cast<float>(fbHeight) / height};
+    }
+    float deltaTime = _deltaTimer.GetDeltaTime();
+    if (deltaTime > 0) {
+        io.DeltaTime = deltaTime;
+    }
+    if (_window && io.WantSetMousePos) {
+        double x = io.MousePos.x, y = io.MousePos.y;
+        runOnMainThread([this, x, y]() { glfwSetCursorPos(_window, x, y); });
+    }
+}
+
 void Tetrium::clearImGuiDrawData()
 {
     ImGui_ImplVulkan_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
+    newImGuiPlatformFrame();
 
     ImGui::NewFrame();
     ImGui::Render();
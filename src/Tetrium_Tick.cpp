@@ -7,15 +7,105 @@
 void Tetrium::Run()
 {
     DEBUG("Starting run loop...");
+    if (_tetraMode == TetraMode::kHeadless) {
+        runHeadless();
+        return;
+    }
     ASSERT(_window);
     glfwShowWindow(_window);
-    while (!glfwWindowShouldClose(_window)) {
-        glfwPollEvents();
-        Tick();
+    if (_renderThreadCtx.enabled) {
+        publishWindowSize();
+        _renderThreadCtx.thread = std::thread(&Tetrium::renderThreadLoop, this);
+        // only handle window events here, sleeping in between;
+        // the render thread wakes this thread up when it has tasks for it
+        while (!glfwWindowShouldClose(_window)) {
+            glfwWaitEvents();
+            publishWindowSize();
+            runMainThreadTasks();
+        }
+        _renderThreadCtx.stop = true;
+        _renderThreadCtx.thread.join();
+        runMainThreadTasks();
+    } else {
+        while (!glfwWindowShouldClose(_window)) {
+            glfwPollEvents();
+            Tick();
+        }
     }
+    // frames may still be in flight
+    vkDeviceWaitIdle(_device->logicalDevice);
     DEBUG("Ending run loop...");
 }
 
+void Tetrium::renderThreadLoop()
+{
+    DEBUG("Render thread started.");
+    Utils::Thread::SetCurrentThreadName("tetrium-render");
+    while (!_renderThreadCtx.stop) {
+        dispatchWindowEvents();
+        Tick();
+    }
+    DEBUG("Render thread stopped.");
+}
+
+void Tetrium::updatePresentThreadScheduling()
+{
+#if __linux__
+    auto& ctx = _presentThreadCtx;
+    if (ctx.requested != ctx.applied) {
+        ctx.applied = ctx.requested;
+        if (ctx.requested) {
+            ctx.savedScheduling = Utils::Thread::GetCurrentThreadScheduling();
+            int core = ctx.requestedCore;
+            if (core < 0) { // isolated cores only run what's pinned to them
+                std::vector<int> isolated = Utils::Thread::GetIsolatedCores();
+                core = isolated.empty() ? Utils::Thread::GetNumCores() - 1 : isolated.front();
+            }
+            ctx.core = Utils::Thread::SetCurrentThreadAffinity(core) ? core : -1;
+            ctx.realtime = Utils::Thread::SetCurrentThreadRealtime();
+            // the highest priority normal threads get
+            ctx.niced = !ctx.realtime && Utils::Thread::SetCurrentThreadNice(-20);
+            INFO(
+                "Present thread: core {}, {}",
+                ctx.core,
+                ctx.realtime ? "SCHED_FIFO" : ctx.niced ? "nice -20" : "normal priority"
+            );
+            if (!ctx.realtime) {
+                WARN("Present thread is not real-time, allow with CAP_SYS_NICE or rtprio limits");
+            }
+        } else {
+            // as launched, e.g. still within the cores `taskset` allowed
+            if (ctx.savedScheduling.has_value()
+                && !Utils::Thread::SetCurrentThreadScheduling(ctx.savedScheduling.value())) {
+                WARN("Failed to restore the present thread's scheduling");
+            }
+            ctx.core = -1;
+            ctx.realtime = false;
+            ctx.niced = false;
+        }
+    }
+
+    if (ctx.switchCounter == nullptr) { // counts the thread that creates it, i.e. this one
+        ctx.switchCounter = std::make_unique<Utils::Thread::ContextSwitchCounter>();
+    }
+    std::optional<Utils::Thread::ContextSwitches> switches = ctx.switchCounter->Read();
+    if (!switches.has_value()) {
+        return;
+    }
+    if (ctx.lastSwitches.has_value()) { // over the last frame
+        uint32_t involuntary = switches->involuntary - ctx.lastSwitches->involuntary;
+        ctx.lastFrameInvoluntarySwitches = involuntary;
+        ctx.involuntarySwitchesPerFrame
+            = ctx.involuntarySwitchesPerFrame * 0.95 + involuntary * 0.05;
+        ctx.numInvoluntarySwitches += involuntary;
+        ctx.numFramesSwitchedOut += involuntary > 0;
+        ctx.history[ctx.numFrames % ctx.history.size()] = involuntary;
+        ctx.numFrames++;
+    }
+    ctx.lastSwitches = switches;
+#endif // __linux__
+}
+
 void Tetrium::getMainProjectionMatrix(glm::mat4& projectionMatrix)
 {
     auto& extent = _swapChain.extent;
@@ -48,6 +138,12 @@ void Tetrium::Tick()
         std::this_thread::yield();
         return;
     }
+    updatePresentThreadScheduling();
+    _frameJournal.BeginFrame(_numTicks);
+    { // start late enough for input & parity to be fresh when the frame submits
+        PROFILE_SCOPE(&_profiler, "Frame Pacing");
+        _framePacer.WaitForFrameStart();
+    }
     _deltaTimer.Tick();
     {
         {
@@ -57,44 +153,392 @@ void Tetrium::Tick()
             _timeSinceStartSeconds += deltaTime;
             _timeSinceStartNanoSeconds += _deltaTimer.GetDeltaTimeNanoSeconds();
             _inputManager.Tick(deltaTime);
+            updateFrameDirtyState();
             TickContext tickData{&_mainCamera, deltaTime};
             tickData.profiler = &_profiler;
+            tickData.extraDrawInstances = _loadGenerator.GetLoad().extraDrawInstances;
+            if (_staticFrameCtx.dirty) { // otherwise last tick's draw data is still up-to-date
+                drawImGui(RGB);          // populate RGB context
+                drawImGui(OCV);          // populate OCV context
+            }
+            { // wait for the GPU to release this frame's resources,
+              // the other frame in flight keeps the GPU busy in the meantime
+                PROFILE_SCOPE(&_profiler, "vkWaitForFences: fenceInFlight");
+                SyncPrimitives& sync = _syncProjector[_currentFrame];
+                VK_CHECK_RESULT(vkWaitForFences(
+                    _device->logicalDevice, 1, &sync.fenceInFlight, VK_TRUE, UINT64_MAX
+                ));
+                VK_CHECK_RESULT(vkResetFences(_device->logicalDevice, 1, &sync.fenceInFlight));
+                // secondary command buffers of this frame are no longer in use
+                for (SecondaryCommandContext& commands :
+                     _parallelRecordingCtx.secondaryCommands[_currentFrame]) {
+                    vkResetCommandPool(_device->logicalDevice, commands.scenePool, 0);
+                    vkResetCommandPool(_device->logicalDevice, commands.imguiPool, 0);
+                }
+            }
+            collectGPUTiming(_currentFrame);
             flushEngineUBOStatic(_currentFrame);
-            drawImGui(RGB); // populate RGB context
-            drawImGui(OCV); // populate OCV context
             drawFrame(&tickData, _currentFrame);
             _currentFrame = (_currentFrame + 1) % NUM_FRAME_IN_FLIGHT;
         }
-        {
-            PROFILE_SCOPE(&_profiler, "GPU: Wait Idle");
-            vkDeviceWaitIdle(this->_device->logicalDevice);
-        }
     }
-    _lastProfilerData = _profiler.NewProfile();
+    _lastProfilerData = &_profiler.NewProfile();
+    _frameJournal.EndFrame(*_lastProfilerData);
+    _scopeStats.AddProfile(*_lastProfilerData, _timingSnapshot.refreshPeriodNanoSeconds);
+    _traceRecorder.SubmitTick(
+        *_lastProfilerData, _numTicks, _frameJournal.CurrentFrame().parityMiss
+    );
+    updateEvenOddCalibration();
+    _loadGenerator.OnFrame(_frameJournal.CurrentFrame().parityMiss);
     _numTicks++;
 }
 
+// cover the whole frame buffer with viewport & scissor
+static void cmdSetFullViewport(VkCommandBuffer CB, VkExtent2D extend)
+{
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = static_cast<float>(extend.width);
+    viewport.height = static_cast<float>(extend.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = extend;
+
+    vkCmdSetViewport(CB, 0, 1, &viewport);
+    vkCmdSetScissor(CB, 0, 1, &scissor);
+}
+
+void Tetrium::recordSceneCommands(const TickContext* ctx, ColorSpace colorSpace)
+{
+    cmdSetFullViewport(ctx->graphics.CB, ctx->graphics.currentFBextend);
+    _renderer.Tick(ctx, colorSpace);
+}
+
+VkImageLayout Tetrium::getVirtualFrameBufferFinalLayout() const
+{
+    return _tetraMode == TetraMode::kDualProjector ? VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+                                                   : VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+}
+
+Tetrium::FrameGraphTargets Tetrium::importFrameGraphTargets(
+    FrameGraph& graph,
+    uint32_t swapchainImageIndex
+)
+{
+    FrameGraphTargets targets;
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        const VirtualFrameBuffer& vfb = _renderContexts[cs].virtualFrameBuffer;
+        // last read by a previous frame's swapchain copy
+        targets.color[cs] = graph.ImportImage(
+            vfb.image[swapchainImageIndex],
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            vfb.layer,
+            FrameGraph::kTransferSrc
+        );
+    }
+    // every pass discards depth, so it only ever needs memory barriers;
+    // the first layer stands in for the whole multiview image array
+    VkImage depth = _multiviewCtx.enabled
+                        ? _multiviewCtx.frameBuffer.depthImage[swapchainImageIndex]
+                        : _swapChain.depthImage[swapchainImageIndex];
+    targets.depth
+        = graph.ImportImage(depth, VK_IMAGE_ASPECT_DEPTH_BIT, 0, FrameGraph::kDepthAttachment);
+    return targets;
+}
+
+std::array<FrameGraph::PassId, ColorSpace::ColorSpaceSize> Tetrium::addColorSpacePasses(
+    const TickContext* ctx,
+    FrameGraph& graph,
+    const FrameGraphTargets& targets,
+    uint32_t swapchainImageIndex
+)
+{
+    static const char* SCENE_PASS_NAMES[] = {"RGB: Scene", "OCV: Scene"};
+    static const char* IMGUI_PASS_NAMES[] = {"RGB: ImGui", "OCV: ImGui"};
+    std::array<FrameGraph::PassId, ColorSpace::ColorSpaceSize> scenePasses;
+
+    vk::Rect2D renderArea(VkOffset2D{0, 0}, _swapChain.extent);
+    // parallel recording fills in secondaries once the graph is compiled, see
+    // `recordSecondaryCommandBuffers()`; the passes only execute them
+    bool parallel = _parallelRecordingCtx.enabled;
+    vk::SubpassContents contents = parallel ? vk::SubpassContents::eSecondaryCommandBuffers
+                                            : vk::SubpassContents::eInline;
+    const auto* secondaryCommands
+        = &_parallelRecordingCtx.secondaryCommands[ctx->graphics.currentFrameInFlight];
+    bool merged = _imguiCtx.mergedIntoMainPass;
+    VkImageLayout finalLayout = getVirtualFrameBufferFinalLayout();
+
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        FrameGraph::Access color{
+            targets.color[cs],
+            FrameGraph::Discard(FrameGraph::kColorAttachment),
+            merged ? finalLayout : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+        };
+        FrameGraph::Access depth{
+            targets.depth,
+            FrameGraph::Discard(FrameGraph::kDepthAttachment),
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+        };
+        scenePasses[cs] = graph.AddPass(
+            SCENE_PASS_NAMES[cs],
+            {color, depth},
+            [=, this](VkCommandBuffer cb) {
+                vk::CommandBuffer primary(cb);
+                vk::RenderPassBeginInfo beginInfo(
+                    _renderContexts[cs].renderPass,
+                    _renderContexts[cs].virtualFrameBuffer.frameBuffer[swapchainImageIndex],
+                    renderArea,
+                    _clearValues.size(),
+                    _clearValues.data()
+                );
+                primary.beginRenderPass(beginInfo, contents);
+                if (parallel) {
+                    primary.executeCommands(vk::CommandBuffer((*secondaryCommands)[cs].sceneCB));
+                } else {
+                    recordSceneCommands(ctx, cs);
+                }
+                // paint imgui, drawImGui() should have been called already
+                if (merged) {
+                    primary.nextSubpass(contents);
+                    if (parallel) {
+                        primary.executeCommands(
+                            vk::CommandBuffer((*secondaryCommands)[cs].imguiCB)
+                        );
+                    } else {
+                        recordImGuiDrawData(cs, primary);
+                    }
+                }
+                primary.endRenderPass();
+            }
+        );
+        if (merged) {
+            continue;
+        }
+
+        graph.AddPass(
+            IMGUI_PASS_NAMES[cs],
+            {{targets.color[cs], FrameGraph::kColorAttachment, finalLayout}},
+            [=, this](VkCommandBuffer cb) {
+                vk::CommandBuffer primary(cb);
+                if (!parallel) {
+                    recordImGuiDrawCommandBuffer(
+                        _imguiCtx, cs, primary, renderArea.extent, swapchainImageIndex
+                    );
+                    return;
+                }
+                vk::RenderPassBeginInfo beginInfo(
+                    _imguiCtx.renderPass,
+                    _imguiCtx.frameBuffers[cs][swapchainImageIndex],
+                    renderArea
+                );
+                primary.beginRenderPass(beginInfo, contents);
+                primary.executeCommands(vk::CommandBuffer((*secondaryCommands)[cs].imguiCB));
+                primary.endRenderPass();
+            }
+        );
+    }
+    return scenePasses;
+}
+
+std::array<FrameGraph::PassId, ColorSpace::ColorSpaceSize> Tetrium::addMultiviewPasses(
+    const TickContext* ctx,
+    FrameGraph& graph,
+    const FrameGraphTargets& targets,
+    uint32_t swapchainImageIndex
+)
+{
+    ASSERT(!_imguiCtx.mergedIntoMainPass);
+    vk::Extent2D extend = _swapChain.extent;
+
+    // scene: a single pass renders every color space into its own layer
+    FrameGraph::ImageState discardColor = FrameGraph::Discard(FrameGraph::kColorAttachment);
+    FrameGraph::PassId scenePass = graph.AddPass(
+        "Multiview: Scene",
+        {{targets.color[RGB], discardColor, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL},
+         {targets.color[OCV], discardColor, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL},
+         {targets.depth,
+          FrameGraph::Discard(FrameGraph::kDepthAttachment),
+          VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL}},
+        [this, ctx, extend, swapchainImageIndex](VkCommandBuffer cb) {
+            vk::CommandBuffer primary(cb);
+            vk::RenderPassBeginInfo renderPassBeginInfo(
+                _multiviewCtx.renderPass,
+                _multiviewCtx.frameBuffer.frameBuffer[swapchainImageIndex],
+                vk::Rect2D(VkOffset2D{0, 0}, extend),
+                _clearValues.size(),
+                _clearValues.data()
+            );
+            primary.beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
+            cmdSetFullViewport(primary, extend);
+            _renderer.TickMultiview(ctx);
+            primary.endRenderPass();
+        }
+    );
+
+    // imgui differs between color spaces, paint it onto each layer
+    static const char* IMGUI_PASS_NAMES[] = {"RGB: ImGui", "OCV: ImGui"};
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        graph.AddPass(
+            IMGUI_PASS_NAMES[cs],
+            {{targets.color[cs], FrameGraph::kColorAttachment, getVirtualFrameBufferFinalLayout()}},
+            [this, cs, extend, swapchainImageIndex](VkCommandBuffer cb) {
+                recordImGuiDrawCommandBuffer(_imguiCtx, cs, cb, extend, swapchainImageIndex);
+            }
+        );
+    }
+    return {scenePass, scenePass};
+}
+
+void Tetrium::recordSecondaryCommandBuffers(
+    const TickContext* ctx,
+    const std::vector<ColorSpace>& colorSpaces,
+    uint32_t swapchainImageIndex
+)
+{
+    auto& secondaryCommands
+        = _parallelRecordingCtx.secondaryCommands[ctx->graphics.currentFrameInFlight];
+
+    // scene: one worker per color space
+    for (ColorSpace cs : colorSpaces) {
+        _threadPool.Push([this, ctx, cs, swapchainImageIndex, &secondaryCommands]() {
+            static constexpr Profiler::ScopeDescriptor SCOPES[ColorSpace::ColorSpaceSize]
+                = {{"Record Scene RGB", __FILE__, __LINE__},
+                   {"Record Scene OCV", __FILE__, __LINE__}};
+            PROFILE_SCOPE_DESCRIPTOR(&_profiler, SCOPES[cs]);
+            vk::CommandBuffer sceneCB(secondaryCommands[cs].sceneCB);
+            vk::CommandBufferInheritanceInfo inheritanceInfo(
+                _renderContexts[cs].renderPass,
+                0,
+                _renderContexts[cs].virtualFrameBuffer.frameBuffer[swapchainImageIndex]
+            );
+            sceneCB.begin(vk::CommandBufferBeginInfo(
+                vk::CommandBufferUsageFlagBits::eRenderPassContinue
+                    | vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+                &inheritanceInfo
+            ));
+            // each worker owns its tick context
+            TickContext workerCtx = *ctx;
+            workerCtx.graphics.CB = sceneCB;
+            recordSceneCommands(&workerCtx, cs);
+            sceneCB.end();
+        });
+    }
+
+    // imgui: its contexts are globals and can't be switched concurrently,
+    // record all of them on this thread while the workers record the scene
+    for (ColorSpace cs : colorSpaces) {
+        vk::CommandBuffer imguiCB(secondaryCommands[cs].imguiCB);
+        vk::CommandBufferInheritanceInfo inheritanceInfo;
+        if (_imguiCtx.mergedIntoMainPass) {
+            inheritanceInfo.renderPass = _renderContexts[cs].renderPass;
+            inheritanceInfo.subpass = 1;
+            inheritanceInfo.framebuffer
+                = _renderContexts[cs].virtualFrameBuffer.frameBuffer[swapchainImageIndex];
+        } else {
+            inheritanceInfo.renderPass = _imguiCtx.renderPass;
+            inheritanceInfo.subpass = 0;
+            inheritanceInfo.framebuffer = _imguiCtx.frameBuffers[cs][swapchainImageIndex];
+        }
+        imguiCB.begin(vk::CommandBufferBeginInfo(
+            vk::CommandBufferUsageFlagBits::eRenderPassContinue
+                | vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+            &inheritanceInfo
+        ));
+        recordImGuiDrawData(cs, imguiCB);
+        imguiCB.end();
+    }
+
+    {
+        PROFILE_SCOPE(&_profiler, "Wait for recording workers");
+        _threadPool.Wait();
+    }
+}
+
+void Tetrium::collectGPUTiming(uint8_t frame)
+{
+    // the device & host clocks drift apart by a few ppm
+    auto now = std::chrono::steady_clock::now();
+    if (now - _lastClockCalibration > std::chrono::seconds(1)) {
+        _clockDomains.Recalibrate();
+        _lastClockCalibration = now;
+    }
+    _gpuProfiler.BeginFrame(frame, _clockDomains, _profiler);
+}
+
+void Tetrium::markFrameDirty()
+{
+    _staticFrameCtx.dirty = true;
+    _staticFrameCtx.lastDirtyTick = _numTicks;
+}
+
+void Tetrium::updateFrameDirtyState()
+{
+    PROFILE_SCOPE(&_profiler, "Update frame dirty state");
+    auto& ctx = _staticFrameCtx;
+    ctx.dirty = false;
+
+    uint64_t numInputEvents = getNumImGuiInputEvents();
+    if (numInputEvents != ctx.lastNumInputEvents) {
+        ctx.lastNumInputEvents = numInputEvents;
+        ctx.lastInputTime = _timeSinceStartSeconds;
+    }
+    bool inputSettling = _timeSinceStartSeconds - ctx.lastInputTime < ctx.inputSettleSeconds;
+
+    bool transformChanged = _renderer.PollTransformChanges();
+    glm::mat4 viewMatrix = _mainCamera.GetViewMatrix();
+    bool cameraChanged = viewMatrix != ctx.lastViewMatrix || _FOV != ctx.lastFOV;
+    ctx.lastViewMatrix = viewMatrix;
+    ctx.lastFOV = _FOV;
+
+    // the GPU load only reaches the GPU through fresh draws, cached frames would hide it
+    bool loadGenerating
+        = _loadGenerator.GetLoad().extraDrawInstances > 0 || _loadGenerator.IsSoaking();
+
+    if (!ctx.enabled || ctx.liveWidgetShown || inputSettling || transformChanged || cameraChanged
+        || loadGenerating) {
+        markFrameDirty();
+    }
+}
+
+bool Tetrium::isCachedFrameValid(uint32_t swapchainImageIndex)
+{
+    for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+        uint64_t renderTick = _renderContexts[cs].virtualFrameBuffer.renderTick[swapchainImageIndex];
+        if (renderTick == VirtualFrameBuffer::NEVER_RENDERED
+            || renderTick < _staticFrameCtx.lastDirtyTick) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void Tetrium::drawFrame(TickContext* ctx, uint8_t frame)
 {
     SyncPrimitives& sync = _syncProjector[frame];
     VkResult result;
     uint32_t swapchainImageIndex;
 
-    { // wait for previous render
-        PROFILE_SCOPE(&_profiler, "vkWaitForFences: fenceInFlight");
-        VK_CHECK_RESULT(vkWaitForFences(_device->logicalDevice, 1, &sync.fenceInFlight, VK_TRUE, UINT64_MAX));
-        VK_CHECK_RESULT(vkResetFences(this->_device->logicalDevice, 1, &sync.fenceInFlight));
-    }
-
-    { // Asynchronously acquire an image from the swap chain,
-        result = vkAcquireNextImageKHR(
-            this->_device->logicalDevice,
-            _swapChain.chain,
-            UINT64_MAX,
-            sync.semaImageAvailable,
-            VK_NULL_HANDLE,
-            &swapchainImageIndex
-        );
+    // `Tick()` has already waited on and reset `sync.fenceInFlight`
+
+    bool headless = _tetraMode == TetraMode::kHeadless;
+    if (headless) { // each frame in flight owns a virtual frame buffer
+        swapchainImageIndex = frame;
+    } else { // Asynchronously acquire an image from the swap chain,
+        do { // in short waits, the present waiter needs the swapchain in between
+            std::unique_lock<std::mutex> lock = lockSwapchain();
+            result = vkAcquireNextImageKHR(
+                this->_device->logicalDevice,
+                _swapChain.chain,
+                SWAPCHAIN_HOLD_NANOSECONDS,
+                sync.semaImageAvailable,
+                VK_NULL_HANDLE,
+                &swapchainImageIndex
+            );
+        } while (result == VK_TIMEOUT);
         [[unlikely]] if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
             _framebufferResized = true;
         } else [[unlikely]] if (result != VK_SUCCESS) {
@@ -103,7 +547,30 @@ void Tetrium::drawFrame(TickContext* ctx, uint8_t frame)
         }
     }
 
-    { // Render RGB, OCV channels onto both frame buffers
+    // nothing has changed since both color spaces got rendered into this image,
+    // only copy the cached image onto the swapchain
+    bool useCachedFrame = !_staticFrameCtx.dirty && isCachedFrameValid(swapchainImageIndex);
+    _staticFrameCtx.lastFrameCached = useCachedFrame;
+    if (useCachedFrame) {
+        _staticFrameCtx.numCachedFrames++;
+    }
+
+    // under parity-predictive rendering, only render the color space that's going to be presented;
+    // static frames render both to fill up the cache
+    std::optional<ColorSpace> predictedColorSpace = std::nullopt;
+    auto predictionTime = std::chrono::steady_clock::now();
+    // multiview renders both color spaces in one go, nothing to save from predicting
+    if (_parityPredictionCtx.enabled && _staticFrameCtx.dirty && !_multiviewCtx.enabled) {
+        predictedColorSpace = predictPresentedColorSpace();
+        if (predictedColorSpace.has_value()) {
+            _parityPredictionCtx.numPredictions++;
+        } else {
+            _parityPredictionCtx.numDualRenders++;
+        }
+    }
+    _parityPredictionCtx.lastFramePredicted = predictedColorSpace.has_value();
+
+    if (!useCachedFrame) { // Render RGB, OCV channels onto both frame buffers
         PROFILE_SCOPE(&_profiler, "Record render commands");
 
         vk::CommandBuffer CB1(_device->graphicsCommandBuffers[frame]);
@@ -118,6 +585,8 @@ void Tetrium::drawFrame(TickContext* ctx, uint8_t frame)
             CB1.begin(vk::CommandBufferBeginInfo());
         }
 
+        GpuProfiler::ScopeId renderScope = _gpuProfiler.Begin(CB1, "Render");
+
         // update graphics rendering context
         ctx->graphics.currentFrameInFlight = frame;
         ctx->graphics.currentSwapchainImageIndex = swapchainImageIndex;
@@ -125,119 +594,147 @@ void Tetrium::drawFrame(TickContext* ctx, uint8_t frame)
         ctx->graphics.currentFBextend = _swapChain.extent;
         getMainProjectionMatrix(ctx->graphics.mainProjectionMatrix);
 
-        { // main render pass
-            vk::Extent2D extend = _swapChain.extent;
-            vk::Rect2D renderArea(VkOffset2D{0, 0}, extend);
-            vk::RenderPassBeginInfo renderPassBeginInfo(
-                {}, {}, renderArea, _clearValues.size(), _clearValues.data(), nullptr
-            );
-
-            VkViewport viewport{};
-            viewport.x = 0.0f;
-            viewport.y = 0.0f;
-            viewport.width = static_cast<float>(extend.width);
-            viewport.height = static_cast<float>(extend.height);
-            viewport.minDepth = 0.0f;
-            viewport.maxDepth = 1.0f;
-
-            VkRect2D scissor{};
-            scissor.offset = {0, 0};
-            scissor.extent = extend;
-
-            // two-pass rendering: render RGB and OCV colors onto two virtual FBs
-            for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
-                renderPassBeginInfo.renderPass = _renderContexts[cs].renderPass;
-                renderPassBeginInfo.framebuffer
-                    = _renderContexts[cs]
-                          .virtualFrameBuffer
-                          .frameBuffer[swapchainImageIndex]; // which frame buffer in the
-                                                             // swapchain do the pass i.e.
-                                                             // all draw calls render to?
-                CB1.beginRenderPass(renderPassBeginInfo, vk::SubpassContents::eInline);
-                vkCmdSetViewport(CB1, 0, 1, &viewport);
-                vkCmdSetScissor(CB1, 0, 1, &scissor);
-                _renderer.Tick(ctx, cs);
-                CB1.endRenderPass();
-
-                // paint imgui, drawImGui() should have been called already
-                recordImGuiDrawCommandBuffer(_imguiCtx, cs, CB1, extend, swapchainImageIndex);
+        // declare every pass of both color spaces; the graph culls those that don't lead to a
+        // virtual frame buffer that may get copied onto the swapchain, and derives the barriers
+        FrameGraph& graph = _frameGraph;
+        graph.Reset();
+        FrameGraphTargets targets = importFrameGraphTargets(graph, swapchainImageIndex);
+        for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+            if (!predictedColorSpace.has_value() || predictedColorSpace.value() == cs) {
+                graph.Export(targets.color[cs], FrameGraph::kTransferSrc);
+            }
+        }
+        std::array<FrameGraph::PassId, ColorSpace::ColorSpaceSize> scenePasses
+            = _multiviewCtx.enabled
+                  ? addMultiviewPasses(ctx, graph, targets, swapchainImageIndex)
+                  : addColorSpacePasses(ctx, graph, targets, swapchainImageIndex);
+        graph.Compile();
+
+        std::vector<ColorSpace> colorSpaces; // color spaces rendered this frame
+        for (ColorSpace cs : {ColorSpace::RGB, ColorSpace::OCV}) {
+            if (graph.IsPassLive(scenePasses[cs])) {
+                _renderContexts[cs].virtualFrameBuffer.renderTick[swapchainImageIndex] = _numTicks;
+                colorSpaces.push_back(cs);
             }
         }
+        if (_parallelRecordingCtx.enabled && !_multiviewCtx.enabled) {
+            recordSecondaryCommandBuffers(ctx, colorSpaces, swapchainImageIndex);
+        }
+        graph.Execute(CB1, &_gpuProfiler);
+        _gpuProfiler.End(CB1, renderScope);
 
         CB1.end();
 
+        // signal `semaRenderFinished` so that the copy submission can chain off the render on the
+        // GPU; the CPU never waits for the render to finish.
         VkSubmitInfo submitInfo{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO};
         std::array<VkCommandBuffer, 1> submitCommandBuffers = {CB1};
         submitInfo.commandBufferCount = static_cast<uint32_t>(submitCommandBuffers.size());
         submitInfo.pCommandBuffers = submitCommandBuffers.data();
-        VkSemaphore signalSemaphores[0];
-        submitInfo.signalSemaphoreCount = 0;
-        submitInfo.pSignalSemaphores = signalSemaphores;
+        std::array<VkSemaphore, 1> signalSemaphores = {sync.semaRenderFinished};
+        submitInfo.signalSemaphoreCount = headless ? 0 : signalSemaphores.size();
+        submitInfo.pSignalSemaphores = signalSemaphores.data();
+        // headless frames end with the render, which then has to signal the frame's fence
+        VkFence fence = headless ? sync.fenceInFlight : VK_NULL_HANDLE;
 
-        vkResetFences(_device->Get(), 1, &sync.fenceRenderFinished);
-        if (vkQueueSubmit(_device->graphicsQueue, 1, &submitInfo, sync.fenceRenderFinished)
-            != VK_SUCCESS) {
+        if (vkQueueSubmit(_device->graphicsQueue, 1, &submitInfo, fence) != VK_SUCCESS) {
             FATAL("Failed to submit draw command buffer!");
         }
-        VK_CHECK_RESULT(vkWaitForFences(_device->logicalDevice, 1, &sync.fenceRenderFinished, VK_TRUE, UINT64_MAX));
+    }
+
+    if (headless) { // nothing to copy onto, nor to present
+        ASSERT(!useCachedFrame); // the fence would never be signaled
+        return;
     }
 
     std::array<VkSemaphore, 1> semaImageCopyFinished;
+    uint64_t surfaceCounter; // sampled for the parity
     { // Copy the channel corresponding to even/odd frame onto swapchain framebuffer
         PROFILE_SCOPE(&_profiler, "Copy to device swapchain");
         // for the image transfer to finish, two resources needs to be ready:
         // 1. the render from the previous CB has to finish for 2 virtual FBs to be available
         // 2. the actual FB needs to be available for copying
         //
-        // for (1) : we use `fenceRenderFinished` -- CPU decides which virtual frame buffer to
-        // commit right before committing
+        // for (1) : we use `semaRenderFinished` -- the GPU waits til rendering finishes, the CPU
+        // only decides which pre-recorded copy to submit, as late as possible
         // for (2) : we use `semaImageAvailable` -- the GPU waits til the actual swapchain is
         // available
 
-        vk::CommandBuffer CB2(_device->graphicsCommandBuffers2[frame]);
-        CB2.reset();
-        CB2.begin(vk::CommandBufferBeginInfo());
-
         // choose whether to render the even/odd frame buffer, discarding the other
-        bool isEven = isEvenFrame();
-        if (_flipEvenOdd) {
-            isEven = !isEven;
+        waitOutImminentVblank(); // no-op until vblank times get published
+        captureTimingSnapshot();
+        surfaceCounter = _timingSnapshot.surfaceCounter;
+        auto sampleTime = _timingSnapshot.captureTime;
+        ColorSpace presentedColorSpace = _timingSnapshot.colorSpace;
+        bool isEven = presentedColorSpace == RGB;
+
+        { // parity prediction bookkeeping
+            auto& predictionCtx = _parityPredictionCtx;
+            double latency
+                = std::chrono::duration<double, std::nano>(sampleTime - predictionTime).count();
+            predictionCtx.predictionToSampleNanoSeconds
+                = predictionCtx.predictionToSampleNanoSeconds * 0.9 + latency * 0.1;
+            if (predictedColorSpace.has_value()) {
+                if (predictedColorSpace.value() == presentedColorSpace) {
+                    predictionCtx.numHits++;
+                } else if (_renderContexts[presentedColorSpace]
+                               .virtualFrameBuffer.renderTick[swapchainImageIndex]
+                           == VirtualFrameBuffer::NEVER_RENDERED) {
+                    // mispredicted, and the right color space has nothing to show;
+                    // fall back to what's been rendered
+                    presentedColorSpace = predictedColorSpace.value();
+                }
+                // otherwise, mispredicted; present the stale image of the right color space,
+                // showing an older frame beats showing the wrong color space
+            }
         }
-        VkImage virtualFramebufferImage
-            = isEven ? _renderContexts[RGB].virtualFrameBuffer.image[swapchainImageIndex]
-                     : _renderContexts[OCV].virtualFrameBuffer.image[swapchainImageIndex];
 
-        VkImage swapchainFramebufferImage = _swapChain.image[swapchainImageIndex];
-        Utils::ImageTransfer::CmdCopyToFB(
-            CB2, virtualFramebufferImage, swapchainFramebufferImage, _swapChain.extent
-        );
-
-        if (isEven != _evenOddDebugCtx.currShouldBeEven) {
+        VkCommandBuffer copyCB
+            = _renderContexts[presentedColorSpace].swapchainCopyCommandBuffers[swapchainImageIndex];
+
+        FrameJournal::FrameRecord& journalRecord = _frameJournal.CurrentFrame();
+        journalRecord.surfaceCounter = surfaceCounter;
+        journalRecord.expectedEven = _evenOddDebugCtx.currShouldBeEven;
+        journalRecord.sampledEven = isEven;
+        journalRecord.predictedColorSpace = predictedColorSpace;
+        journalRecord.presentedColorSpace = presentedColorSpace;
+        // the virtual display tells where presents actually land instead, see below
+        if (isEven != _evenOddDebugCtx.currShouldBeEven
+            && _tetraMode != TetraMode::kEvenOddVirtualSync) {
             _evenOddDebugCtx.numDroppedFrames++;
+            journalRecord.parityMiss = true;
         }
         _evenOddDebugCtx.currShouldBeEven = !isEven; // advance to next frame
-        CB2.end();
 
-        // submit CB2
         VkSubmitInfo submitInfo2{.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO};
-        std::array<VkCommandBuffer, 1> submitCommandBuffers2 = {CB2};
-        std::array<VkSemaphore, 1> semaImageAvailable = {sync.semaImageAvailable};
-        std::array<VkPipelineStageFlags, 1> semaImageAvailableStages
-            = {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
+        // cached frames have no render submission to wait on
+        std::array<VkSemaphore, 2> waitSemaphores = {sync.semaImageAvailable, sync.semaRenderFinished};
+        std::array<VkPipelineStageFlags, 2> waitStages
+            = {VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT};
         semaImageCopyFinished = {sync.semaImageCopyFinished};
 
-        submitInfo2.waitSemaphoreCount = semaImageAvailable.size();
-        submitInfo2.pWaitSemaphores = semaImageAvailable.data();
-        submitInfo2.pWaitDstStageMask = semaImageAvailableStages.data();
-        submitInfo2.commandBufferCount = static_cast<uint32_t>(submitCommandBuffers2.size());
-        submitInfo2.pCommandBuffers = submitCommandBuffers2.data();
+        submitInfo2.waitSemaphoreCount = useCachedFrame ? 1 : waitSemaphores.size();
+        submitInfo2.pWaitSemaphores = waitSemaphores.data();
+        submitInfo2.pWaitDstStageMask = waitStages.data();
+        // the begin timestamp waits along with the copy, timing only the copy itself
+        std::optional<GpuProfiler::Wrapper> copyWrapper
+            = _gpuProfiler.WrapSubmission("Swapchain Copy", VK_PIPELINE_STAGE_TRANSFER_BIT);
+        std::array<VkCommandBuffer, 3> copyCommandBuffers = {copyCB};
+        if (copyWrapper.has_value()) {
+            copyCommandBuffers = {copyWrapper->begin, copyCB, copyWrapper->end};
+        }
+        submitInfo2.commandBufferCount = copyWrapper.has_value() ? 3 : 1;
+        submitInfo2.pCommandBuffers = copyCommandBuffers.data();
         submitInfo2.signalSemaphoreCount = semaImageCopyFinished.size();
         submitInfo2.pSignalSemaphores = semaImageCopyFinished.data();
 
         if (vkQueueSubmit(_device->graphicsQueue, 1, &submitInfo2, sync.fenceInFlight)
             != VK_SUCCESS) {
-            FATAL("Failed to submit draw command buffer!");
+            FATAL("Failed to submit copy command buffer!");
         }
+        auto submitTime = std::chrono::steady_clock::now();
+        _framePacer.OnSubmit(submitTime);
+        journalRecord.submitTime = submitTime;
     }
 
     { // Presented the swapchain, which at this point contains a rendered RGB/OCV image
@@ -277,11 +774,31 @@ void Tetrium::drawFrame(TickContext* ctx, uint8_t frame)
             .pTimes = &presentTime
         };
 
+        // linux counts vblanks from present completions instead, see `_presentWaitCtx`
+        VkPresentIdKHR presentId{.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR, .swapchainCount = 1};
+        uint64_t id;
+
         if (_tetraMode == TetraMode::kEvenOddSoftwareSync) {
+#if __linux__
+            id = queuePresentId();
+            presentId.pPresentIds = &id;
+            presentInfo.pNext = &presentId;
+#else
             presentInfo.pNext = &presentTimeInfo;
+#endif // __linux__
         }
 
-        result = vkQueuePresentKHR(_device->presentationQueue, &presentInfo);
+        {
+            std::unique_lock<std::mutex> lock = lockSwapchain();
+            result = vkQueuePresentKHR(_device->presentationQueue, &presentInfo);
+        }
+        FrameJournal::FrameRecord& journalRecord = _frameJournal.CurrentFrame();
+        journalRecord.presentTime = std::chrono::steady_clock::now();
+        if (_tetraMode == TetraMode::kEvenOddVirtualSync
+            && _virtualDisplay.Present(surfaceCounter).parityMiss) {
+            _evenOddDebugCtx.numDroppedFrames++; // shown with the other parity's color space
+            journalRecord.parityMiss = true;
+        }
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR
             || this->_framebufferResized) {
             ASSERT(
@@ -411,3 +411,73 @@ GLFWwindow* Tetrium::initGLFW(bool promptUserForFullScreenWindow)
     
     return window;
 }
+
+// sizes are packed as [width, height] into the high & low 32 bits
+static uint64_t packSize(int width, int height)
+{
+    return (static_cast<uint64_t>(width) << 32) | static_cast<uint32_t>(height);
+}
+
+static void unpackSize(uint64_t size, int& width, int& height)
+{
+    width = static_cast<int>(size >> 32);
+    height = static_cast<int>(size & UINT32_MAX);
+}
+
+void Tetrium::getWindowSize(int& width, int& height)
+{
+    if (!_window) {
+        width = _swapChain.extent.width;
+        height = _swapChain.extent.height;
+    } else if (_renderThreadCtx.enabled) {
+        unpackSize(_renderThreadCtx.windowSize.load(std::memory_order_acquire), width, height);
+    } else {
+        glfwGetWindowSize(_window, &width, &height);
+    }
+}
+
+void Tetrium::getFramebufferSize(int& width, int& height)
+{
+    if (!_window) {
+        width = _swapChain.extent.width;
+        height = _swapChain.extent.height;
+    } else if (_renderThreadCtx.enabled) {
+        unpackSize(
+            _renderThreadCtx.framebufferSize.load(std::memory_order_acquire), width, height
+        );
+    } else {
+        glfwGetFramebufferSize(_window, &width, &height);
+    }
+}
+
+void Tetrium::publishWindowSize()
+{
+    int width, height;
+    glfwGetWindowSize(_window, &width, &height);
+    _renderThreadCtx.windowSize.store(packSize(width, height), std::memory_order_release);
+    glfwGetFramebufferSize(_window, &width, &height);
+    _renderThreadCtx.framebufferSize.store(packSize(width, height), std::memory_order_release);
+}
+
+void Tetrium::runOnMainThread(std::function<void()> task)
+{
+    if (!_renderThreadCtx.enabled) {
+        task();
+        return;
+    }
+    while (!_renderThreadCtx.mainThreadTasks.TryPush(std::move(task))) {
+        if (_renderThreadCtx.stop) { // the main thread has stopped serving tasks
+            return;
+        }
+        std::this_thread::yield();
+    }
+    glfwPostEmptyEvent(); // wake up the main thread from `glfwWaitEvents()`
+}
+
+void Tetrium::runMainThreadTasks()
+{
+    while (std::optional<std::function<void()>> task
+           = _renderThreadCtx.mainThreadTasks.TryPop()) {
+        task.value()();
+    }
+}
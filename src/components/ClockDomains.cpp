@@ -0,0 +1,190 @@
+#include <array>
+#include <cmath>
+#include <limits>
+#include <time.h>
+#include <vector>
+
+#include "ClockDomains.h"
+
+namespace
+{
+#if __linux__
+uint64_t readClock(clockid_t clock)
+{
+    timespec time;
+    clock_gettime(clock, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1'000'000'000ull + time.tv_nsec;
+}
+
+uint64_t readMonotonic() { return readClock(CLOCK_MONOTONIC); }
+
+uint64_t readMonotonicRaw() { return readClock(CLOCK_MONOTONIC_RAW); }
+#endif // __linux__
+
+// the clock present timings are reported in
+uint64_t readPresentClock()
+{
+#if __linux__
+    return readMonotonic();
+#elif __APPLE__ // MoltenVK reports `mach_absolute_time()`, in nanoseconds
+    return clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif // __linux__
+}
+
+uint64_t steadyNow()
+{
+    auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count();
+}
+
+// calibrations to pick the tightest one from
+const int NUM_CALIBRATION_ATTEMPTS = 4;
+} // namespace
+
+void ClockDomains::Init(
+    VkInstance instance,
+    VkPhysicalDevice physicalDevice,
+    VkDevice device,
+    bool calibratedTimestamps,
+    uint32_t timestampValidBits
+)
+{
+    _device = device;
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    _timestampPeriodNanoSeconds = properties.limits.timestampPeriod;
+    _timestampMask = timestampValidBits >= 64 ? std::numeric_limits<uint64_t>::max()
+                                              : (1ull << timestampValidBits) - 1;
+    _getCalibratedTimestamps = nullptr;
+    _hostDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+    _calibration.reset();
+
+#if __linux__
+    if (calibratedTimestamps && timestampValidBits > 0) {
+        auto getTimeDomains = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(
+            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT")
+        );
+        uint32_t numDomains = 0;
+        std::vector<VkTimeDomainEXT> domains;
+        if (getTimeDomains) {
+            getTimeDomains(physicalDevice, &numDomains, nullptr);
+            domains.resize(numDomains);
+            getTimeDomains(physicalDevice, &numDomains, domains.data());
+        }
+        bool hasDevice = false;
+        for (VkTimeDomainEXT domain : domains) {
+            if (domain == VK_TIME_DOMAIN_DEVICE_EXT) {
+                hasDevice = true;
+            } else if (domain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT) {
+                _hostDomain = domain; // the steady clock itself, preferred
+            } else if (domain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT
+                       && _hostDomain != VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT) {
+                _hostDomain = domain;
+            }
+        }
+        if (hasDevice && _hostDomain != VK_TIME_DOMAIN_DEVICE_EXT) {
+            _getCalibratedTimestamps = reinterpret_cast<PFN_vkGetCalibratedTimestampsEXT>(
+                vkGetDeviceProcAddr(device, "vkGetCalibratedTimestampsEXT")
+            );
+        }
+    }
+#endif // __linux__
+    Recalibrate();
+}
+
+void ClockDomains::Recalibrate()
+{
+    _presentOffsetNanoSeconds = measureOffset(readPresentClock);
+    if (_getCalibratedTimestamps == nullptr) {
+        return;
+    }
+#if __linux__
+    _hostDomainOffsetNanoSeconds = measureOffset(
+        _hostDomain == VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT ? readMonotonic : readMonotonicRaw
+    );
+#endif // __linux__
+
+    std::array<VkCalibratedTimestampInfoEXT, 2> infos = {
+        VkCalibratedTimestampInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT,
+            .timeDomain = VK_TIME_DOMAIN_DEVICE_EXT
+        },
+        VkCalibratedTimestampInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT, .timeDomain = _hostDomain
+        }
+    };
+    std::optional<Calibration> best;
+    for (int i = 0; i < NUM_CALIBRATION_ATTEMPTS; i++) {
+        std::array<uint64_t, 2> timestamps; // [device, host]
+        uint64_t maxDeviation;
+        if (_getCalibratedTimestamps(
+                _device, infos.size(), infos.data(), timestamps.data(), &maxDeviation
+            )
+            != VK_SUCCESS) {
+            continue;
+        }
+        if (!best.has_value() || maxDeviation < best->maxDeviationNanoSeconds) {
+            int64_t hostNanoSeconds = timestamps[1] + _hostDomainOffsetNanoSeconds;
+            best = Calibration{
+                timestamps[0], TimePoint(std::chrono::nanoseconds(hostNanoSeconds)), maxDeviation
+            };
+        }
+    }
+    if (best.has_value()) { // otherwise keep the last calibration around
+        _calibration = best;
+    }
+}
+
+std::optional<ClockDomains::TimePoint> ClockDomains::DeviceToHost(uint64_t deviceTicks) const
+{
+    if (!_calibration.has_value()) {
+        return std::nullopt;
+    }
+    // timestamps wrap around at `timestampValidBits`; anything within half the range before
+    // the calibration is in the past
+    uint64_t delta = (deviceTicks - _calibration->deviceTicks) & _timestampMask;
+    double ticks = delta > _timestampMask / 2 ? -static_cast<double>(_timestampMask - delta + 1)
+                                              : static_cast<double>(delta);
+    return _calibration->hostTime
+           + std::chrono::nanoseconds(std::llround(ticks * _timestampPeriodNanoSeconds));
+}
+
+std::optional<uint64_t> ClockDomains::HostToDevice(TimePoint time) const
+{
+    if (!_calibration.has_value()) {
+        return std::nullopt;
+    }
+    double nanoSeconds
+        = std::chrono::duration<double, std::nano>(time - _calibration->hostTime).count();
+    int64_t ticks = std::llround(nanoSeconds / _timestampPeriodNanoSeconds);
+    return (_calibration->deviceTicks + static_cast<uint64_t>(ticks)) & _timestampMask;
+}
+
+ClockDomains::TimePoint ClockDomains::PresentToHost(uint64_t presentNanoSeconds) const
+{
+    return TimePoint(std::chrono::nanoseconds(presentNanoSeconds + _presentOffsetNanoSeconds));
+}
+
+uint64_t ClockDomains::HostToPresent(TimePoint time) const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count()
+           - _presentOffsetNanoSeconds;
+}
+
+int64_t ClockDomains::measureOffset(uint64_t (*read)())
+{
+    int64_t offset = 0;
+    uint64_t tightest = std::numeric_limits<uint64_t>::max();
+    for (int i = 0; i < NUM_CALIBRATION_ATTEMPTS; i++) {
+        uint64_t before = steadyNow();
+        uint64_t time = read();
+        uint64_t after = steadyNow();
+        if (after - before < tightest) {
+            tightest = after - before;
+            offset = static_cast<int64_t>(before + (after - before) / 2 - time);
+        }
+    }
+    return offset;
+}
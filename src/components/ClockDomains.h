@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vulkan/vulkan_core.h>
+
+// Puts the clocks that time a frame's events onto the steady clock's timeline:
+// - the device's, ticking timestamp queries; calibrated against the host's monotonic clock
+//   with VK_EXT_calibrated_timestamps
+// - the presentation engine's, e.g. `VkPastPresentationTimingGOOGLE`, in nanoseconds of the
+//   OS's monotonic clock
+// The device and host clocks drift apart by a few ppm, `Recalibrate()` every now and then.
+class ClockDomains
+{
+  public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    // a device timestamp and the host time it was taken at
+    struct Calibration
+    {
+        uint64_t deviceTicks = 0;
+        TimePoint hostTime;
+        uint64_t maxDeviationNanoSeconds = 0; // how far apart the two reads may be
+    };
+
+    // CALIBRATEDTIMESTAMPS: whether VK_EXT_calibrated_timestamps is enabled on DEVICE;
+    // TIMESTAMPVALIDBITS of the queue whose timestamps get converted
+    void Init(
+        VkInstance instance,
+        VkPhysicalDevice physicalDevice,
+        VkDevice device,
+        bool calibratedTimestamps,
+        uint32_t timestampValidBits
+    );
+
+    bool IsDeviceCalibrated() const { return _calibration.has_value(); }
+    const std::optional<Calibration>& GetCalibration() const { return _calibration; }
+    // steady clock minus the presentation clock, 0 wherever both are the monotonic clock
+    int64_t GetPresentOffsetNanoSeconds() const { return _presentOffsetNanoSeconds; }
+
+    // re-pair the device & host clocks, and the presentation & steady clocks
+    void Recalibrate();
+
+    // `std::nullopt` while the device clock is uncalibrated
+    std::optional<TimePoint> DeviceToHost(uint64_t deviceTicks) const;
+    std::optional<uint64_t> HostToDevice(TimePoint time) const;
+
+    TimePoint PresentToHost(uint64_t presentNanoSeconds) const;
+    uint64_t HostToPresent(TimePoint time) const;
+
+  private:
+    // steady clock minus the clock read by READ, both in nanoseconds;
+    // bracketed reads keep the pairing error within the steady clock's read latency
+    static int64_t measureOffset(uint64_t (*read)());
+
+    PFN_vkGetCalibratedTimestampsEXT _getCalibratedTimestamps = nullptr;
+    VkDevice _device = VK_NULL_HANDLE;
+    VkTimeDomainEXT _hostDomain = VK_TIME_DOMAIN_DEVICE_EXT; // the device clock's counterpart
+    int64_t _hostDomainOffsetNanoSeconds = 0; // steady clock minus `_hostDomain`
+    double _timestampPeriodNanoSeconds = 0;
+    uint64_t _timestampMask = 0;
+    std::optional<Calibration> _calibration;
+    int64_t _presentOffsetNanoSeconds = 0;
+};
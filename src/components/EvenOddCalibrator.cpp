@@ -0,0 +1,267 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "EvenOddCalibrator.h"
+
+namespace
+{
+// weight of each neighbor's frames in a bin's smoothed estimate
+const double NEIGHBOR_WEIGHT = 0.5;
+
+// probability that any of NUMBINS intervals of half-width Z misses its drop rate, as an upper
+// bound; all of them have to hold for the chosen bin to be the best
+double confidenceForZ(double z, uint32_t numBins)
+{
+    return std::max(0.0, 1.0 - numBins * std::erfc(z / std::sqrt(2.0)));
+}
+
+double zForConfidence(double confidence, uint32_t numBins)
+{
+    double low = 0;
+    double high = 8;
+    for (int i = 0; i < 64; i++) {
+        double mid = (low + high) / 2;
+        (confidenceForZ(mid, numBins) < confidence ? low : high) = mid;
+    }
+    return high;
+}
+} // namespace
+
+void EvenOddCalibrator::Start(int64_t rangeNanoSeconds, const Config& config)
+{
+    _config = config;
+    _config.numBins = std::max(_config.numBins, 2u);
+    _bins.assign(_config.numBins, Bin{});
+    for (uint32_t i = 0; i < _config.numBins; i++) {
+        _bins[i].offsetNanoSeconds = rangeNanoSeconds * i / _config.numBins;
+    }
+    _z = zForConfidence(_config.confidence, _config.numBins);
+    _currentBin = 0;
+    _batchFrames = 0;
+    _numFrames = 0;
+    _running = true;
+}
+
+void EvenOddCalibrator::Cancel() { _running = false; }
+
+int64_t EvenOddCalibrator::GetOffset() const { return _bins[_currentBin].offsetNanoSeconds; }
+
+void EvenOddCalibrator::OnFrame(bool parityMiss)
+{
+    if (!_running) {
+        return;
+    }
+    _numFrames++;
+    _batchFrames++;
+    if (_batchFrames > _config.settleFrames) { // the offset switch itself may cost a frame
+        Bin& bin = _bins[_currentBin];
+        bin.numFrames++;
+        bin.numMisses += parityMiss;
+    }
+    if (_batchFrames < _config.settleFrames + _config.framesPerBatch) {
+        return;
+    }
+
+    updateIntervals(_z);
+    bool swept = std::all_of(_bins.begin(), _bins.end(), [](const Bin& bin) {
+        return bin.numFrames > 0;
+    });
+    if (swept && (isSeparated(findLeader()) || _numFrames >= _config.maxFrames)) {
+        finish();
+        return;
+    }
+    pickNextBin();
+}
+
+float EvenOddCalibrator::GetProgress() const
+{
+    if (!_running) {
+        return _result.has_value() ? 1.f : 0.f;
+    }
+    float progress = static_cast<float>(_numFrames) / _config.maxFrames;
+    if (_bins[_config.numBins - 1].numFrames > 0) { // swept, count the settled contenders
+        const Bin& leader = _bins[findLeader()];
+        uint32_t numResolved = std::count_if(_bins.begin(), _bins.end(), [&](const Bin& bin) {
+            return &bin != &leader
+                   && (bin.eliminated || bin.lower >= leader.upper - _config.tolerance);
+        }); // the others, the leader only settles along with them
+        progress = std::max(progress, static_cast<float>(numResolved) / (_config.numBins - 1));
+    }
+    return std::min(progress, 1.f);
+}
+
+void EvenOddCalibrator::updateIntervals(double z)
+{
+    for (uint32_t i = 0; i < _bins.size(); i++) {
+        double numFrames = _bins[i].numFrames;
+        double numMisses = _bins[i].numMisses;
+        for (uint32_t neighbor : {i - 1, i + 1}) { // out of range past either end
+            if (neighbor < _bins.size()) {
+                numFrames += NEIGHBOR_WEIGHT * _bins[neighbor].numFrames;
+                numMisses += NEIGHBOR_WEIGHT * _bins[neighbor].numMisses;
+            }
+        }
+        Bin& bin = _bins[i];
+        if (numFrames == 0) {
+            bin.dropRate = 0;
+            bin.lower = 0;
+            bin.upper = 1;
+            continue;
+        }
+        // Wilson score interval, sound for rates near 0 where drops are rare
+        double rate = numMisses / numFrames;
+        double z2n = z * z / numFrames;
+        double center = (rate + z2n / 2) / (1 + z2n);
+        double halfWidth
+            = z / (1 + z2n) * std::sqrt(rate * (1 - rate) / numFrames + z2n / (4 * numFrames));
+        bin.dropRate = rate;
+        bin.lower = std::max(0.0, center - halfWidth);
+        bin.upper = std::min(1.0, center + halfWidth);
+    }
+    const Bin& leader = _bins[findLeader()];
+    for (Bin& bin : _bins) {
+        bin.eliminated = bin.numFrames > 0 && bin.lower > leader.upper;
+    }
+}
+
+uint32_t EvenOddCalibrator::findLeader() const
+{
+    uint32_t leader = 0;
+    for (uint32_t i = 1; i < _bins.size(); i++) {
+        const Bin& bin = _bins[i];
+        const Bin& best = _bins[leader];
+        if (bin.numFrames == 0) {
+            continue;
+        }
+        // ties go to the tighter estimate, then the smaller offset
+        if (best.numFrames == 0 || bin.dropRate < best.dropRate
+            || (bin.dropRate == best.dropRate && bin.upper < best.upper)) {
+            leader = i;
+        }
+    }
+    return leader;
+}
+
+std::optional<uint32_t> EvenOddCalibrator::findChallenger(uint32_t leader) const
+{
+    std::optional<uint32_t> challenger;
+    for (uint32_t i = 0; i < _bins.size(); i++) {
+        if (i == leader || _bins[i].eliminated) {
+            continue;
+        }
+        if (!challenger.has_value() || _bins[i].lower < _bins[challenger.value()].lower) {
+            challenger = i;
+        }
+    }
+    return challenger;
+}
+
+bool EvenOddCalibrator::isSeparated(uint32_t leader) const
+{
+    std::optional<uint32_t> challenger = findChallenger(leader);
+    // the challenger has the lowest lower bound of the contenders, the rest are further off
+    return !challenger.has_value()
+           || _bins[challenger.value()].lower >= _bins[leader].upper - _config.tolerance;
+}
+
+void EvenOddCalibrator::pickNextBin()
+{
+    uint32_t next = _currentBin;
+    auto unsampled = std::find_if(_bins.begin(), _bins.end(), [](const Bin& bin) {
+        return bin.numFrames == 0;
+    });
+    if (unsampled != _bins.end()) { // first sweep
+        next = unsampled - _bins.begin();
+    } else { // narrow whichever of the two is the least known
+        uint32_t leader = findLeader();
+        next = leader;
+        std::optional<uint32_t> challenger = findChallenger(leader);
+        if (challenger.has_value()
+            && _bins[challenger.value()].numFrames < _bins[leader].numFrames) {
+            next = challenger.value();
+        }
+    }
+    // staying on the same offset needs no settling
+    _batchFrames = next == _currentBin ? _config.settleFrames : 0;
+    _currentBin = next;
+}
+
+void EvenOddCalibrator::finish()
+{
+    _running = false;
+    uint32_t leader = findLeader();
+    double confidence = _config.confidence;
+    if (!isSeparated(leader)) { // out of frames; how sure can we be with what we have
+        double low = 0;
+        double high = _z;
+        for (int i = 0; i < 32; i++) {
+            double mid = (low + high) / 2;
+            updateIntervals(mid);
+            (isSeparated(findLeader()) ? low : high) = mid;
+        }
+        confidence = confidenceForZ(low, _config.numBins);
+        updateIntervals(_z);
+        leader = findLeader();
+    }
+    const Bin& bin = _bins[leader];
+    _result = Result{
+        .offsetNanoSeconds = bin.offsetNanoSeconds,
+        .dropRate = bin.dropRate,
+        .lower = bin.lower,
+        .upper = bin.upper,
+        .confidence = confidence,
+        .numFrames = _numFrames
+    };
+    _currentBin = leader;
+}
+
+std::optional<EvenOddCalibrator::Result> EvenOddCalibrator::Load(
+    const std::string& path,
+    const std::string& key
+)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) { // "<key>\t<result>"
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.substr(0, tab) != key) {
+            continue;
+        }
+        Result result;
+        std::istringstream fields(line.substr(tab + 1));
+        fields >> result.offsetNanoSeconds >> result.dropRate >> result.lower >> result.upper
+            >> result.confidence >> result.numFrames;
+        if (fields.fail()) {
+            return std::nullopt;
+        }
+        return result;
+    }
+    return std::nullopt;
+}
+
+bool EvenOddCalibrator::Save(const std::string& path, const std::string& key, const Result& result)
+{
+    std::vector<std::string> lines; // other keys' results stay
+    {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.compare(0, key.size() + 1, key + '\t') != 0) {
+                lines.push_back(line);
+            }
+        }
+    }
+    std::ostringstream line;
+    line << key << '\t' << result.offsetNanoSeconds << ' ' << result.dropRate << ' '
+         << result.lower << ' ' << result.upper << ' ' << result.confidence << ' '
+         << result.numFrames;
+    lines.push_back(line.str());
+
+    std::ofstream file(path, std::ios::trunc);
+    for (const std::string& l : lines) {
+        file << l << '\n';
+    }
+    return file.good();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Finds the timing offset with the fewest parity misses, one frame at a time.
+// The offset range is split into bins; each bin's drop probability is estimated from the frames
+// run at its offset, smoothed with its neighbors' since drop rates vary smoothly with the
+// offset, and bounded by Wilson score intervals. Bins get sampled adaptively (LUCB): after one
+// sweep, only the leading bin & its closest challenger are run, until their intervals separate
+// or every contender is within `Config::tolerance` of the leader.
+// Used from the render thread: `GetOffset()` before each frame, `OnFrame()` after it.
+class EvenOddCalibrator
+{
+  public:
+    struct Config
+    {
+        uint32_t numBins = 12;
+        uint32_t framesPerBatch = 30; // frames run per bin before picking the next one
+        uint32_t settleFrames = 2;    // frames ignored after switching bins
+        // that the chosen bin is the best, across all bins
+        double confidence = 0.95;
+        // drop rates closer than this are as good as each other
+        double tolerance = 0.01;
+        uint64_t maxFrames = 3600; // give up separating after this many, i.e. 1 min at 60Hz
+    };
+
+    struct Bin
+    {
+        int64_t offsetNanoSeconds = 0;
+        uint64_t numFrames = 0;
+        uint64_t numMisses = 0;
+        double dropRate = 0; // smoothed estimate
+        double lower = 0;    // smoothed interval
+        double upper = 1;
+        bool eliminated = false; // certainly worse than the leader
+    };
+
+    struct Result
+    {
+        int64_t offsetNanoSeconds = 0;
+        double dropRate = 0;
+        double lower = 0;
+        double upper = 0;
+        // that no other bin is better by more than `Config::tolerance`;
+        // `Config::confidence` unless the calibration ran out of frames
+        double confidence = 0;
+        uint64_t numFrames = 0;
+    };
+
+    // calibrate over [0, RANGENANOSECONDS)
+    void Start(int64_t rangeNanoSeconds, const Config& config);
+    void Cancel();
+    bool IsRunning() const { return _running; }
+
+    int64_t GetOffset() const; // to run the next frame at
+    // account for a frame run at `GetOffset()`; PARITYMISS: it showed the wrong color space
+    void OnFrame(bool parityMiss);
+
+    float GetProgress() const;
+    const std::vector<Bin>& GetBins() const { return _bins; }
+    const std::optional<Result>& GetResult() const { return _result; } // of the last calibration
+
+    // results persist as one line per KEY, e.g. per display mode
+    static std::optional<Result> Load(const std::string& path, const std::string& key);
+    static bool Save(const std::string& path, const std::string& key, const Result& result);
+
+  private:
+    void updateIntervals(double z);
+    uint32_t findLeader() const;
+    // the contender with the lowest lower bound other than LEADER, if any
+    std::optional<uint32_t> findChallenger(uint32_t leader) const;
+    bool isSeparated(uint32_t leader) const; // with the intervals as last updated
+    void pickNextBin();
+    void finish();
+
+    Config _config;
+    bool _running = false;
+    std::vector<Bin> _bins;
+    uint32_t _currentBin = 0;
+    uint32_t _batchFrames = 0; // run in the current batch, including the settling ones
+    uint64_t _numFrames = 0;
+    double _z = 0; // interval width for `_config.confidence`, corrected for the number of bins
+    std::optional<Result> _result;
+};
@@ -0,0 +1,306 @@
+#include "FrameGraph.h"
+#include "GpuProfiler.h"
+
+const FrameGraph::ImageState FrameGraph::kColorAttachment{
+    VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+    VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+};
+
+const FrameGraph::ImageState FrameGraph::kDepthAttachment{
+    VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+    VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+};
+
+const FrameGraph::ImageState FrameGraph::kTransferSrc{
+    VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+    VK_ACCESS_2_TRANSFER_READ_BIT,
+    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+};
+
+const FrameGraph::ImageState FrameGraph::kTransferDst{
+    VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+    VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+};
+
+// the presentation engine is synchronized through semaphores, no stage nor access to wait on
+const FrameGraph::ImageState FrameGraph::kPresent{
+    VK_PIPELINE_STAGE_2_NONE,
+    VK_ACCESS_2_NONE,
+    VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+};
+
+namespace
+{
+const VkAccessFlags2 WRITE_ACCESS_MASK
+    = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT
+      | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT
+      | VK_ACCESS_2_HOST_WRITE_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+bool discardsContent(const FrameGraph::Access& access)
+{
+    return access.state.layout == VK_IMAGE_LAYOUT_UNDEFINED;
+}
+
+// whether ACCESS modifies the image's content or layout
+bool isWrite(const FrameGraph::Access& access)
+{
+    return (access.state.access & WRITE_ACCESS_MASK) || discardsContent(access)
+           || (access.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED
+               && access.finalLayout != access.state.layout);
+}
+
+VkPipelineStageFlags toLegacyStage(VkPipelineStageFlags2 stage, VkPipelineStageFlags none)
+{
+    return stage == VK_PIPELINE_STAGE_2_NONE ? none : static_cast<VkPipelineStageFlags>(stage);
+}
+} // namespace
+
+void FrameGraph::Init(VkDevice device, bool synchronization2)
+{
+    _cmdPipelineBarrier2 = nullptr;
+    if (synchronization2) {
+        _cmdPipelineBarrier2 = reinterpret_cast<PFN_vkCmdPipelineBarrier2KHR>(
+            vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier2KHR")
+        );
+        if (!_cmdPipelineBarrier2) {
+            WARN("vkCmdPipelineBarrier2KHR not found, falling back to vkCmdPipelineBarrier");
+        }
+    }
+    Reset();
+}
+
+void FrameGraph::Reset()
+{
+    _resources.clear();
+    _passes.clear();
+    _accesses.clear();
+    _imageBarriers.clear();
+    _memoryBarrier = {.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+    _compiled = false;
+    _stats = Stats{};
+}
+
+FrameGraph::ResourceId FrameGraph::ImportImage(
+    VkImage image,
+    VkImageAspectFlags aspect,
+    uint32_t layer,
+    ImageState state
+)
+{
+    Resource& resource = _resources.emplace_back();
+    resource.image = image;
+    resource.aspect = aspect;
+    resource.layer = layer;
+    resource.layout = state.layout;
+    if (state.access & WRITE_ACCESS_MASK) {
+        resource.writeStage = state.stage;
+        resource.writeAccess = state.access & WRITE_ACCESS_MASK;
+    } else {
+        resource.readStages = state.stage;
+    }
+    return _resources.size() - 1;
+}
+
+void FrameGraph::Export(ResourceId resource, ImageState state)
+{
+    ASSERT(resource < _resources.size());
+    _resources[resource].exported = true;
+    _resources[resource].exportState = state;
+}
+
+FrameGraph::PassId FrameGraph::AddPass(
+    const char* name,
+    std::initializer_list<Access> accesses,
+    std::function<void(VkCommandBuffer)> record
+)
+{
+    ASSERT(!_compiled);
+    Pass& pass = _passes.emplace_back();
+    pass.name = name;
+    pass.firstAccess = _accesses.size();
+    pass.numAccesses = accesses.size();
+    pass.record = std::move(record);
+    for (const Access& access : accesses) {
+        ASSERT(access.resource < _resources.size());
+        _accesses.push_back(access);
+    }
+    _stats.numPasses++;
+    return _passes.size() - 1;
+}
+
+void FrameGraph::Compile()
+{
+    // walk backwards from the exports: a pass is live if it writes a resource whose content
+    // is still needed, which makes everything it doesn't discard needed as well
+    std::vector<bool> needed(_resources.size());
+    for (size_t i = 0; i < _resources.size(); i++) {
+        needed[i] = _resources[i].exported;
+    }
+    _stats.numCulledPasses = 0;
+    for (auto pass = _passes.rbegin(); pass != _passes.rend(); pass++) {
+        auto begin = _accesses.begin() + pass->firstAccess;
+        auto end = begin + pass->numAccesses;
+        pass->live = std::any_of(begin, end, [&needed](const Access& access) {
+            return isWrite(access) && needed[access.resource];
+        });
+        if (!pass->live) {
+            _stats.numCulledPasses++;
+            continue;
+        }
+        for (auto access = begin; access != end; access++) {
+            needed[access->resource] = !discardsContent(*access);
+        }
+    }
+    _compiled = true;
+}
+
+bool FrameGraph::IsPassLive(PassId pass) const
+{
+    ASSERT(_compiled);
+    ASSERT(pass < _passes.size());
+    return _passes[pass].live;
+}
+
+void FrameGraph::Execute(VkCommandBuffer cb, GpuProfiler* gpuProfiler)
+{
+    if (!_compiled) {
+        Compile();
+    }
+    for (const Pass& pass : _passes) {
+        if (!pass.live) {
+            continue;
+        }
+        for (uint32_t i = 0; i < pass.numAccesses; i++) {
+            const Access& access = _accesses[pass.firstAccess + i];
+            syncAccess(_resources[access.resource], access);
+        }
+        flushBarriers(cb);
+        if (gpuProfiler) { // passes begin & end their render passes, the scope stays outside
+            GpuProfiler::ScopeId scope = gpuProfiler->Begin(cb, pass.name);
+            pass.record(cb);
+            gpuProfiler->End(cb, scope);
+        } else {
+            pass.record(cb);
+        }
+    }
+
+    // hand exported resources over in the layout they're consumed in
+    for (Resource& resource : _resources) {
+        if (resource.exported && resource.exportState.layout != VK_IMAGE_LAYOUT_UNDEFINED
+            && resource.exportState.layout != resource.layout) {
+            syncAccess(resource, Access{.state = resource.exportState});
+        }
+    }
+    flushBarriers(cb);
+}
+
+void FrameGraph::syncAccess(Resource& resource, const Access& access)
+{
+    const ImageState& state = access.state;
+    bool discard = discardsContent(access);
+    bool transition = !discard && state.layout != resource.layout;
+    bool writes = isWrite(access) || transition;
+    VkPipelineStageFlags2 prevStages = resource.writeStage | resource.readStages;
+
+    if (transition) { // layout transitions are writes, and wait on everything before them
+        VkImageMemoryBarrier2& barrier = _imageBarriers.emplace_back();
+        barrier = {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2};
+        barrier.srcStageMask = prevStages;
+        barrier.srcAccessMask = resource.writeAccess;
+        barrier.dstStageMask = state.stage;
+        barrier.dstAccessMask = state.access;
+        barrier.oldLayout = resource.layout;
+        barrier.newLayout = state.layout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = resource.image;
+        barrier.subresourceRange = {resource.aspect, 0, 1, resource.layer, 1};
+    } else if (writes && prevStages != VK_PIPELINE_STAGE_2_NONE) {
+        // write-after-write needs the previous write to be made available;
+        // write-after-read only has to wait for the reads to finish
+        _memoryBarrier.srcStageMask |= prevStages;
+        _memoryBarrier.dstStageMask |= state.stage;
+        if (resource.writeAccess != VK_ACCESS_2_NONE) {
+            _memoryBarrier.srcAccessMask |= resource.writeAccess;
+            _memoryBarrier.dstAccessMask |= state.access;
+        }
+    } else if (!writes && resource.writeStage != VK_PIPELINE_STAGE_2_NONE
+               && (state.stage & ~resource.syncedStages)) {
+        // read-after-write, unless an earlier read at the same stages already synced
+        _memoryBarrier.srcStageMask |= resource.writeStage;
+        _memoryBarrier.srcAccessMask |= resource.writeAccess;
+        _memoryBarrier.dstStageMask |= state.stage;
+        _memoryBarrier.dstAccessMask |= state.access;
+    } // read-after-read in the same layout needs nothing
+
+    if (writes) {
+        resource.writeStage = state.stage;
+        resource.writeAccess = state.access & WRITE_ACCESS_MASK;
+        resource.readStages = VK_PIPELINE_STAGE_2_NONE;
+        resource.syncedStages = state.stage;
+    } else {
+        resource.readStages |= state.stage;
+        resource.syncedStages |= state.stage;
+    }
+    resource.layout
+        = access.finalLayout != VK_IMAGE_LAYOUT_UNDEFINED ? access.finalLayout : state.layout;
+}
+
+void FrameGraph::flushBarriers(VkCommandBuffer cb)
+{
+    bool hasMemoryBarrier = _memoryBarrier.srcStageMask != VK_PIPELINE_STAGE_2_NONE
+                            || _memoryBarrier.dstStageMask != VK_PIPELINE_STAGE_2_NONE;
+    if (!hasMemoryBarrier && _imageBarriers.empty()) {
+        return;
+    }
+    _stats.numBarriers++;
+    _stats.numImageBarriers += _imageBarriers.size();
+
+    if (_cmdPipelineBarrier2) {
+        VkDependencyInfo dependencyInfo{.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+        dependencyInfo.memoryBarrierCount = hasMemoryBarrier ? 1 : 0;
+        dependencyInfo.pMemoryBarriers = &_memoryBarrier;
+        dependencyInfo.imageMemoryBarrierCount = _imageBarriers.size();
+        dependencyInfo.pImageMemoryBarriers = _imageBarriers.data();
+        _cmdPipelineBarrier2(cb, &dependencyInfo);
+    } else { // legacy barriers take a single pair of stage masks for the whole batch
+        VkPipelineStageFlags2 srcStages = _memoryBarrier.srcStageMask;
+        VkPipelineStageFlags2 dstStages = _memoryBarrier.dstStageMask;
+        VkMemoryBarrier memoryBarrier{.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+        memoryBarrier.srcAccessMask = static_cast<VkAccessFlags>(_memoryBarrier.srcAccessMask);
+        memoryBarrier.dstAccessMask = static_cast<VkAccessFlags>(_memoryBarrier.dstAccessMask);
+        _legacyImageBarriers.clear();
+        for (const VkImageMemoryBarrier2& barrier2 : _imageBarriers) {
+            srcStages |= barrier2.srcStageMask;
+            dstStages |= barrier2.dstStageMask;
+            VkImageMemoryBarrier& barrier = _legacyImageBarriers.emplace_back();
+            barrier = {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+            barrier.srcAccessMask = static_cast<VkAccessFlags>(barrier2.srcAccessMask);
+            barrier.dstAccessMask = static_cast<VkAccessFlags>(barrier2.dstAccessMask);
+            barrier.oldLayout = barrier2.oldLayout;
+            barrier.newLayout = barrier2.newLayout;
+            barrier.srcQueueFamilyIndex = barrier2.srcQueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = barrier2.dstQueueFamilyIndex;
+            barrier.image = barrier2.image;
+            barrier.subresourceRange = barrier2.subresourceRange;
+        }
+        vkCmdPipelineBarrier(
+            cb,
+            toLegacyStage(srcStages, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT),
+            toLegacyStage(dstStages, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+            0,
+            hasMemoryBarrier ? 1 : 0,
+            &memoryBarrier,
+            0,
+            nullptr,
+            _legacyImageBarriers.size(),
+            _legacyImageBarriers.data()
+        );
+    }
+
+    _memoryBarrier = {.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+    _imageBarriers.clear();
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+class GpuProfiler;
+
+// A single command buffer's worth of passes, each declaring the images it reads and writes.
+// `Compile()` culls passes whose output never reaches an exported image; `Execute()` records
+// the live passes with the barriers they need in between, batched into one call per pass.
+// Meant to be rebuilt every frame; `Reset()` keeps the allocations around.
+class FrameGraph
+{
+  public:
+    using ResourceId = uint32_t;
+    using PassId = uint32_t;
+
+    // how an image is accessed, and the layout it has to be in.
+    // Stages and accesses only use bits that have a legacy equivalent,
+    // so that devices without synchronization2 can fall back to `vkCmdPipelineBarrier`.
+    struct ImageState
+    {
+        VkPipelineStageFlags2 stage = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 access = VK_ACCESS_2_NONE;
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    };
+
+    static const ImageState kColorAttachment; // read & written by a render pass
+    static const ImageState kDepthAttachment;
+    static const ImageState kTransferSrc;
+    static const ImageState kTransferDst;
+    static const ImageState kPresent;
+
+    // STATE, for a pass that overwrites the whole image without reading it first
+    static ImageState Discard(ImageState state)
+    {
+        state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        return state;
+    }
+
+    struct Access
+    {
+        ResourceId resource;
+        // `state.layout` is the layout the pass expects on entry;
+        // UNDEFINED if the pass discards the content, e.g. a render pass clearing the image
+        ImageState state;
+        // layout the pass leaves the image in, e.g. a render pass's final layout;
+        // UNDEFINED if the pass leaves it in `state.layout`
+        VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    };
+
+    struct Stats
+    {
+        uint32_t numPasses = 0;
+        uint32_t numCulledPasses = 0;
+        uint32_t numBarriers = 0; // pipeline barrier commands recorded
+        uint32_t numImageBarriers = 0;
+    };
+
+    // SYNCHRONIZATION2: whether VK_KHR_synchronization2 is enabled on DEVICE
+    void Init(VkDevice device, bool synchronization2);
+    bool IsSynchronization2() const { return _cmdPipelineBarrier2 != nullptr; }
+
+    void Reset();
+
+    // an image (layer) living outside of the graph, last accessed in STATE before the graph
+    ResourceId ImportImage(
+        VkImage image,
+        VkImageAspectFlags aspect,
+        uint32_t layer,
+        ImageState state
+    );
+
+    // RESOURCE gets consumed in STATE after the graph, keeping alive the passes that write it
+    void Export(ResourceId resource, ImageState state);
+
+    PassId AddPass(
+        const char* name,
+        std::initializer_list<Access> accesses,
+        std::function<void(VkCommandBuffer)> record
+    );
+
+    // cull passes that don't contribute to any exported resource
+    void Compile();
+    bool IsPassLive(PassId pass) const;
+
+    // record the live passes and their barriers into CB, compiling first if needed;
+    // each pass gets timed in a GPU scope of its name if GPUPROFILER is given
+    void Execute(VkCommandBuffer cb, GpuProfiler* gpuProfiler = nullptr);
+
+    const Stats& GetStats() const { return _stats; }
+
+  private:
+    struct Resource
+    {
+        VkImage image;
+        VkImageAspectFlags aspect;
+        uint32_t layer;
+        VkImageLayout layout; // current layout
+        // last write, including layout transitions
+        VkPipelineStageFlags2 writeStage = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+        // stages that read since the last write, and those the last write is visible to
+        VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+        VkPipelineStageFlags2 syncedStages = VK_PIPELINE_STAGE_2_NONE;
+        bool exported = false;
+        ImageState exportState;
+    };
+
+    struct Pass
+    {
+        const char* name;
+        uint32_t firstAccess; // into `_accesses`
+        uint32_t numAccesses;
+        std::function<void(VkCommandBuffer)> record;
+        bool live = true;
+    };
+
+    // fold ACCESS's hazards against RESOURCE's history into the pending barriers
+    void syncAccess(Resource& resource, const Access& access);
+    void flushBarriers(VkCommandBuffer cb);
+
+    std::vector<Resource> _resources;
+    std::vector<Pass> _passes;
+    std::vector<Access> _accesses;
+    bool _compiled = false;
+
+    // barriers pending for the next pass
+    VkMemoryBarrier2 _memoryBarrier;
+    std::vector<VkImageMemoryBarrier2> _imageBarriers;
+    std::vector<VkImageMemoryBarrier> _legacyImageBarriers; // `_imageBarriers`, without sync2
+
+    PFN_vkCmdPipelineBarrier2KHR _cmdPipelineBarrier2 = nullptr;
+    Stats _stats;
+};
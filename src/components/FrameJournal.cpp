@@ -0,0 +1,162 @@
+#include <algorithm>
+
+#include "lib/Utils.h"
+
+#include "FrameJournal.h"
+
+namespace
+{
+// a scope is over budget when it takes this many times its usual time,
+const double OVER_BUDGET_FACTOR = 1.5;
+// and at least this much longer; shorter blips can't cost a vblank
+const int64_t MIN_OVERRUN_NANOSECONDS = 250'000;
+// weight of a new frame in the scopes' moving averages
+const double BASELINE_WEIGHT = 0.02;
+} // namespace
+
+void FrameJournal::Init(uint32_t numFrames, uint32_t framesPerSnapshot)
+{
+    _framesPerSnapshot = std::min(framesPerSnapshot, numFrames);
+    _frames.assign(numFrames, FrameRecord{});
+    for (Snapshot& snapshot : _snapshots) {
+        snapshot.frames.assign(_framesPerSnapshot, FrameRecord{});
+    }
+    _numFramesRecorded = 0;
+    _numMisses = 0;
+    _baselines.fill(Baseline{});
+    _lastFrameEnd = TimePoint{};
+}
+
+FrameJournal::FrameRecord& FrameJournal::BeginFrame(uint64_t tick)
+{
+    FrameRecord& record = _frames[_numFramesRecorded % _frames.size()];
+    _numFramesRecorded++;
+    record = FrameRecord{.tick = tick};
+    return record;
+}
+
+FrameJournal::FrameRecord& FrameJournal::CurrentFrame()
+{
+    ASSERT(_numFramesRecorded > 0);
+    return _frames[(_numFramesRecorded - 1) % _frames.size()];
+}
+
+void FrameJournal::EndFrame(const std::vector<Profiler::Entry>& profile)
+{
+    FrameRecord& record = CurrentFrame();
+    TimePoint now = std::chrono::steady_clock::now();
+
+    int64_t scopedNanoSeconds = 0;
+    uint32_t threadId = Utils::Thread::GetCurrentThreadId(); // the frame's
+    for (const Profiler::Entry& entry : profile) {
+        int64_t nanoSeconds
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(entry.end - entry.begin).count();
+        // other threads' & GPU entries overlap the frame's own
+        if (entry.level == 0 && !entry.gpu && entry.threadId == threadId) {
+            scopedNanoSeconds += nanoSeconds;
+        }
+        if (record.numScopes < MAX_SCOPES) {
+            record.scopes[record.numScopes++] = {entry.name, entry.level, nanoSeconds};
+        }
+    }
+    if (_lastFrameEnd != TimePoint{}) {
+        int64_t frameNanoSeconds
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _lastFrameEnd).count();
+        record.scopes[record.numScopes++]
+            = {OUTSIDE_SCOPES, 0, std::max<int64_t>(frameNanoSeconds - scopedNanoSeconds, 0)};
+    }
+    _lastFrameEnd = now;
+
+    if (record.parityMiss) { // before the miss's own times skew the baselines
+        _numMisses++;
+        takeSnapshot();
+    }
+    for (uint32_t i = 0; i < record.numScopes; i++) {
+        const Scope& scope = record.scopes[i];
+        Baseline* baseline = findBaseline(scope.name);
+        if (baseline == nullptr) {
+            continue;
+        }
+        if (baseline->nanoSeconds == 0) {
+            baseline->nanoSeconds = scope.nanoSeconds;
+        }
+        baseline->nanoSeconds += BASELINE_WEIGHT * (scope.nanoSeconds - baseline->nanoSeconds);
+    }
+}
+
+uint32_t FrameJournal::GetNumSnapshots() const
+{
+    return std::min<uint64_t>(_numMisses, NUM_SNAPSHOTS);
+}
+
+const FrameJournal::Snapshot& FrameJournal::GetSnapshot(uint32_t i) const
+{
+    ASSERT(i < GetNumSnapshots());
+    return _snapshots[(_numMisses - 1 - i) % NUM_SNAPSHOTS];
+}
+
+void FrameJournal::ClearSnapshots() { _numMisses = 0; }
+
+FrameJournal::Baseline* FrameJournal::findBaseline(const char* name)
+{
+    for (Baseline& baseline : _baselines) {
+        if (baseline.name == name) {
+            return &baseline;
+        }
+        if (baseline.name == nullptr) {
+            baseline.name = name;
+            return &baseline;
+        }
+    }
+    return nullptr;
+}
+
+void FrameJournal::takeSnapshot()
+{
+    Snapshot& snapshot = _snapshots[(_numMisses - 1) % NUM_SNAPSHOTS];
+    snapshot.numFrames = std::min<uint64_t>(_framesPerSnapshot, _numFramesRecorded);
+    snapshot.numCulprits = 0;
+    uint64_t first = _numFramesRecorded - snapshot.numFrames;
+    for (uint32_t i = 0; i < snapshot.numFrames; i++) { // oldest first
+        snapshot.frames[i] = _frames[(first + i) % _frames.size()];
+    }
+    snapshot.missTick = snapshot.frames[snapshot.numFrames - 1].tick;
+
+    for (uint32_t i = 0; i < snapshot.numFrames; i++) {
+        const FrameRecord& frame = snapshot.frames[i];
+        for (uint32_t j = 0; j < frame.numScopes; j++) {
+            const Scope& scope = frame.scopes[j];
+            Baseline* baseline = findBaseline(scope.name);
+            if (baseline == nullptr || baseline->nanoSeconds == 0) {
+                continue; // nothing usual to compare against yet
+            }
+            int64_t usual = baseline->nanoSeconds;
+            if (scope.nanoSeconds < usual * OVER_BUDGET_FACTOR
+                || scope.nanoSeconds - usual < MIN_OVERRUN_NANOSECONDS) {
+                continue;
+            }
+            auto culprit = std::find_if(
+                snapshot.culprits.begin(),
+                snapshot.culprits.begin() + snapshot.numCulprits,
+                [&scope](const Culprit& culprit) { return culprit.name == scope.name; }
+            );
+            if (culprit == snapshot.culprits.begin() + snapshot.numCulprits) {
+                if (snapshot.numCulprits == MAX_CULPRITS) {
+                    continue; // too many suspects, the worst ones are likely in already
+                }
+                snapshot.numCulprits++;
+                *culprit = Culprit{scope.name, 0, 0, usual};
+            }
+            culprit->numFrames++;
+            culprit->worstNanoSeconds = std::max(culprit->worstNanoSeconds, scope.nanoSeconds);
+        }
+    }
+    std::sort(
+        snapshot.culprits.begin(),
+        snapshot.culprits.begin() + snapshot.numCulprits,
+        [](const Culprit& a, const Culprit& b) {
+            return a.worstNanoSeconds - a.usualNanoSeconds
+                   > b.worstNanoSeconds - b.usualNanoSeconds;
+        }
+    );
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "Profiler.h"
+#include "structs/ColorSpace.h"
+
+// Per-frame history of the parity decisions and where the frame's time went.
+// Every parity miss freezes the frames leading up to it into a snapshot, along with the
+// profiler scopes that ran over their usual time, so drops can be traced back to their cause.
+// Storage is allocated once in `Init()`; recording never allocates. Used from a single thread.
+class FrameJournal
+{
+  public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    // profiler scopes kept per frame, the rest dropped; one more for `OUTSIDE_SCOPES`
+    static const uint32_t MAX_SCOPES = 32;
+    static const uint32_t MAX_CULPRITS = 8;  // over-budget scopes kept per snapshot
+    static const uint32_t NUM_SNAPSHOTS = 8; // the oldest snapshot gets overwritten
+    // name of the pseudo-scope covering the frame time outside of any top-level scope,
+    // i.e. the OS & the loop itself
+    static constexpr const char* OUTSIDE_SCOPES = "(outside scopes)";
+
+    struct Scope
+    {
+        const char* name;
+        int level;
+        int64_t nanoSeconds;
+    };
+
+    struct FrameRecord
+    {
+        uint64_t tick = 0;
+        uint64_t surfaceCounter = 0; // sampled for the parity
+        bool expectedEven = false;   // the parity the frame should have had
+        bool sampledEven = false;
+        bool parityMiss = false;
+        std::optional<ColorSpace> predictedColorSpace; // by parity-predictive rendering
+        std::optional<ColorSpace> presentedColorSpace;
+        TimePoint submitTime;  // the parity-dependent copy got submitted
+        TimePoint presentTime; // `vkQueuePresentKHR()` returned
+        uint32_t numScopes = 0;
+        std::array<Scope, MAX_SCOPES + 1> scopes;
+    };
+
+    // a scope that took much longer than usual in the frames leading up to a miss
+    struct Culprit
+    {
+        const char* name;
+        uint32_t numFrames;       // frames it was over budget in
+        int64_t worstNanoSeconds; // its longest run in those frames
+        int64_t usualNanoSeconds; // its moving average before the miss
+    };
+
+    struct Snapshot
+    {
+        uint64_t missTick;
+        uint32_t numFrames = 0; // the last one is the miss
+        std::vector<FrameRecord> frames;
+        uint32_t numCulprits = 0;
+        std::array<Culprit, MAX_CULPRITS> culprits; // worst overrun first
+    };
+
+    // FRAMESPERSNAPSHOT: frames frozen per miss, including the miss itself
+    void Init(uint32_t numFrames, uint32_t framesPerSnapshot);
+
+    // start recording a new frame; valid until the next `BeginFrame()`
+    FrameRecord& BeginFrame(uint64_t tick);
+    FrameRecord& CurrentFrame(); // the frame since the last `BeginFrame()`
+    // PROFILE: the frame's profiler entries; snapshots the frame if it missed its parity
+    void EndFrame(const std::vector<Profiler::Entry>& profile);
+
+    uint64_t GetNumMisses() const { return _numMisses; }
+    uint32_t GetNumSnapshots() const; // snapshots available
+    // I-th most recent snapshot, 0 being the latest
+    const Snapshot& GetSnapshot(uint32_t i) const;
+    void ClearSnapshots(); // the frame history & usual scope times stay
+
+  private:
+    struct Baseline
+    {
+        const char* name = nullptr;
+        double nanoSeconds = 0; // moving average
+    };
+
+    // moving average of NAME's time, by pointer since scope names are literals;
+    // nullptr if the table is full
+    Baseline* findBaseline(const char* name);
+    void takeSnapshot();
+
+    std::vector<FrameRecord> _frames; // ring
+    uint64_t _numFramesRecorded = 0;
+    uint32_t _framesPerSnapshot = 0;
+    std::array<Snapshot, NUM_SNAPSHOTS> _snapshots; // ring
+    uint64_t _numMisses = 0;
+    std::array<Baseline, 64> _baselines;
+    TimePoint _lastFrameEnd; // frames span from the previous `EndFrame()` to their own
+};
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "FramePacer.h"
+
+namespace
+{
+// weight of a new sample in the stats' moving averages
+const double MOVING_AVERAGE_WEIGHT = 0.05;
+// the PLL's period stays within this fraction of the nominal period
+const double MAX_PERIOD_DRIFT = 0.05;
+} // namespace
+
+void FramePacer::Init(const Config& config)
+{
+    _config = config;
+    _stats = {};
+    _nominalPeriodNanoSeconds = 0;
+    _locked = false;
+    _targetVblank.reset();
+    _workDeviationNanoSeconds = 0;
+}
+
+void FramePacer::SetNominalPeriod(uint64_t nanoSeconds)
+{
+    double drift = std::abs(static_cast<double>(nanoSeconds) - _nominalPeriodNanoSeconds);
+    if (drift <= _nominalPeriodNanoSeconds * MAX_PERIOD_DRIFT) {
+        return; // software sync refines its period estimate all the time
+    }
+    _nominalPeriodNanoSeconds = nanoSeconds;
+    _locked = false;
+    _stats.locked = false;
+}
+
+void FramePacer::ObserveVblank(uint64_t counter, Clock::time_point time)
+{
+    _stats.numObservations++;
+    if (!_locked) {
+        if (_nominalPeriodNanoSeconds == 0) {
+            return; // nothing to predict with
+        }
+        _locked = true;
+        _refCounter = counter;
+        _refTime = time;
+        _periodNanoSeconds = _nominalPeriodNanoSeconds;
+        _stats.locked = true;
+        _stats.periodNanoSeconds = _periodNanoSeconds;
+        return;
+    }
+    if (counter <= _refCounter) { // no newer vblank
+        return;
+    }
+
+    uint64_t numPeriods = counter - _refCounter;
+    Clock::time_point predicted
+        = _refTime + std::chrono::nanoseconds(std::llround(numPeriods * _periodNanoSeconds));
+    double error = std::chrono::duration<double, std::nano>(time - predicted).count();
+    if (std::abs(error) > _periodNanoSeconds / 2) { // lost track, e.g. a mode switch; start over
+        _stats.numRelocks++;
+        _refCounter = counter;
+        _refTime = time;
+        _periodNanoSeconds = _nominalPeriodNanoSeconds;
+        _stats.periodNanoSeconds = _periodNanoSeconds;
+        return;
+    }
+
+    _refCounter = counter;
+    _refTime = predicted + std::chrono::nanoseconds(std::llround(_config.phaseGain * error));
+    _periodNanoSeconds += _config.periodGain * error / numPeriods;
+    _periodNanoSeconds = std::clamp(
+        _periodNanoSeconds,
+        _nominalPeriodNanoSeconds * (1 - MAX_PERIOD_DRIFT),
+        _nominalPeriodNanoSeconds * (1 + MAX_PERIOD_DRIFT)
+    );
+
+    _stats.periodNanoSeconds = _periodNanoSeconds;
+    _stats.phaseErrorNanoSeconds += MOVING_AVERAGE_WEIGHT
+                                    * (std::abs(error) - _stats.phaseErrorNanoSeconds);
+}
+
+std::optional<FramePacer::Clock::time_point> FramePacer::PredictVblankAfter(
+    Clock::time_point time
+) const
+{
+    if (!_locked) {
+        return std::nullopt;
+    }
+    double sinceRef = std::chrono::duration<double, std::nano>(time - _refTime).count();
+    double numPeriods = std::floor(sinceRef / _periodNanoSeconds) + 1;
+    return _refTime + std::chrono::nanoseconds(std::llround(numPeriods * _periodNanoSeconds));
+}
+
+void FramePacer::WaitForFrameStart()
+{
+    Clock::time_point now = Clock::now();
+    _frameStart = now;
+    _targetVblank.reset();
+    // budget for a pessimistic frame
+    double work = _stats.workNanoSeconds + 2 * _workDeviationNanoSeconds;
+    double lead = work + _config.safetyMarginNanoSeconds;
+    if (!_config.enabled || !_locked || lead >= _periodNanoSeconds) {
+        return; // render as soon as possible, as without pacing
+    }
+
+    // the first vblank the frame can make it for
+    Clock::time_point earliest = now + std::chrono::nanoseconds(std::llround(lead));
+    Clock::time_point target = PredictVblankAfter(earliest).value();
+    Clock::time_point start = target - std::chrono::nanoseconds(std::llround(lead));
+    waitUntil(start);
+    _frameStart = Clock::now();
+    _targetVblank = target;
+    _stats.numPacedFrames++;
+}
+
+void FramePacer::OnSubmit(Clock::time_point time)
+{
+    double work = std::chrono::duration<double, std::nano>(time - _frameStart).count();
+    if (_stats.workNanoSeconds == 0) {
+        _stats.workNanoSeconds = work;
+    }
+    _workDeviationNanoSeconds += MOVING_AVERAGE_WEIGHT
+                                 * (std::abs(work - _stats.workNanoSeconds)
+                                    - _workDeviationNanoSeconds);
+    _stats.workNanoSeconds += MOVING_AVERAGE_WEIGHT * (work - _stats.workNanoSeconds);
+    if (_targetVblank.has_value() && time >= _targetVblank.value()) {
+        _stats.numLateFrames++;
+    }
+}
+
+void FramePacer::waitUntil(Clock::time_point time)
+{
+    Clock::time_point begin = Clock::now();
+    Clock::time_point spinBegin = time - std::chrono::nanoseconds(_config.spinNanoSeconds);
+    if (spinBegin > begin) {
+        std::this_thread::sleep_until(spinBegin);
+    }
+    Clock::time_point woken = Clock::now();
+    while (Clock::now() < time) {
+        std::this_thread::yield();
+    }
+    Clock::time_point end = Clock::now();
+
+    double slept = std::chrono::duration<double, std::nano>(woken - begin).count();
+    double spun = std::chrono::duration<double, std::nano>(end - woken).count();
+    _stats.sleepNanoSeconds += MOVING_AVERAGE_WEIGHT * (slept - _stats.sleepNanoSeconds);
+    _stats.spinNanoSeconds += MOVING_AVERAGE_WEIGHT * (spun - _stats.spinNanoSeconds);
+}
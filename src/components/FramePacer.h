@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+// Starts frames just in time: a phase-locked loop tracks when vblanks happen from observed
+// (counter, time) pairs, and `WaitForFrameStart()` holds back the frame until it can finish
+// its work, i.e. submit, a safety margin before the next vblank.
+// Used from a single thread.
+class FramePacer
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config
+    {
+        bool enabled = false; // otherwise frames start right away, only the stats get updated
+        // submit at least this long before the targeted vblank
+        int64_t safetyMarginNanoSeconds = 1'000'000;
+        // sleep until this long before the frame start, then spin;
+        // covers the scheduler's wake-up latency
+        int64_t spinNanoSeconds = 500'000;
+        // PLL gains, applied per observation: phase correction & period correction
+        double phaseGain = 0.2;
+        double periodGain = 0.02;
+    };
+
+    struct Stats
+    {
+        bool locked = false;
+        double periodNanoSeconds = 0;
+        double phaseErrorNanoSeconds = 0; // moving average of |observed - predicted| vblank time
+        double workNanoSeconds = 0;       // estimated frame start to submission
+        uint64_t numObservations = 0;
+        uint64_t numRelocks = 0; // observations too far off the prediction, the PLL restarted
+        uint64_t numPacedFrames = 0;
+        uint64_t numLateFrames = 0; // submitted after the targeted vblank
+        double sleepNanoSeconds = 0; // moving averages of the wait per paced frame
+        double spinNanoSeconds = 0;
+    };
+
+    void Init(const Config& config);
+    // the refresh period the display reports, 0 if unknown; seeds the PLL and bounds how far
+    // its period may drift. Restarts the PLL if the period changed, e.g. on a mode switch
+    void SetNominalPeriod(uint64_t nanoSeconds);
+
+    Config& GetConfig() { return _config; }
+    const Stats& GetStats() const { return _stats; }
+
+    // vblank COUNTER happened at TIME
+    void ObserveVblank(uint64_t counter, Clock::time_point time);
+
+    // predicted time of the first vblank after TIME, `std::nullopt` until locked
+    std::optional<Clock::time_point> PredictVblankAfter(Clock::time_point time) const;
+
+    // block until the frame should start; returns right away while disabled or unlocked,
+    // or if the frame's work doesn't fit in a refresh period
+    void WaitForFrameStart();
+    // the frame started by the last `WaitForFrameStart()` submitted its parity-dependent work
+    void OnSubmit(Clock::time_point time);
+
+  private:
+    // sleep until `time - _config.spinNanoSeconds`, then spin until TIME
+    void waitUntil(Clock::time_point time);
+
+    Config _config;
+    Stats _stats;
+    double _nominalPeriodNanoSeconds = 0;
+
+    // the PLL: vblank `_refCounter` happened at `_refTime`, the next ones every period
+    bool _locked = false;
+    uint64_t _refCounter = 0;
+    Clock::time_point _refTime;
+    double _periodNanoSeconds = 0;
+
+    Clock::time_point _frameStart;
+    std::optional<Clock::time_point> _targetVblank; // of the frame in progress
+    double _workDeviationNanoSeconds = 0; // moving average of |work - estimate|
+};
@@ -0,0 +1,204 @@
+#include <algorithm>
+
+#include "GpuProfiler.h"
+
+void GpuProfiler::Init(
+    VkDevice device,
+    uint32_t queueFamilyIndex,
+    uint32_t timestampValidBits,
+    double timestampPeriodNanoSeconds,
+    uint32_t numFrames
+)
+{
+    ASSERT(_frames.empty());
+    _device = device;
+    _timestampPeriodNanoSeconds = timestampPeriodNanoSeconds;
+    if (timestampValidBits == 0 || timestampPeriodNanoSeconds <= 0) {
+        return;
+    }
+    _timestampMask = timestampValidBits >= 64 ? ~0ull : (1ull << timestampValidBits) - 1;
+    _frames.resize(numFrames);
+    for (FrameContext& frame : _frames) {
+        VkQueryPoolCreateInfo queryPoolInfo{
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .queryType = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount = 2 * MAX_SCOPES
+        };
+        VK_CHECK_RESULT(vkCreateQueryPool(device, &queryPoolInfo, nullptr, &frame.queryPool));
+
+        VkCommandPoolCreateInfo commandPoolInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .queueFamilyIndex = queueFamilyIndex
+        };
+        VK_CHECK_RESULT(
+            vkCreateCommandPool(device, &commandPoolInfo, nullptr, &frame.commandPool)
+        );
+        std::array<VkCommandBuffer, 2 * MAX_WRAPPED_SUBMISSIONS> cbs;
+        VkCommandBufferAllocateInfo allocInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = frame.commandPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = static_cast<uint32_t>(cbs.size())
+        };
+        VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &allocInfo, cbs.data()));
+        for (uint32_t i = 0; i < MAX_WRAPPED_SUBMISSIONS; i++) {
+            frame.wrappers[i] = {cbs[2 * i], cbs[2 * i + 1]};
+        }
+        frame.scopes.reserve(MAX_SCOPES);
+    }
+    _results.reserve(2 * MAX_SCOPES);
+}
+
+void GpuProfiler::Cleanup()
+{
+    for (FrameContext& frame : _frames) {
+        vkDestroyQueryPool(_device, frame.queryPool, nullptr);
+        vkDestroyCommandPool(_device, frame.commandPool, nullptr); // frees the wrappers
+    }
+    _frames.clear();
+}
+
+void GpuProfiler::BeginFrame(uint32_t frame, const ClockDomains& clockDomains, Profiler& profiler)
+{
+    if (_frames.empty()) {
+        return;
+    }
+    FrameContext& ctx = _frames[frame];
+    collect(ctx, clockDomains, profiler);
+    ctx.scopes.clear();
+    if (ctx.numWrappers > 0) {
+        VK_CHECK_RESULT(vkResetCommandPool(_device, ctx.commandPool, 0));
+        ctx.numWrappers = 0;
+    }
+    _currentFrame = frame;
+    _currentLevel = 0;
+}
+
+GpuProfiler::ScopeId GpuProfiler::Begin(VkCommandBuffer cb, const char* name)
+{
+    return beginScope(cb, name, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+}
+
+void GpuProfiler::End(VkCommandBuffer cb, ScopeId scope)
+{
+    if (scope == INVALID_SCOPE) {
+        return;
+    }
+    FrameContext& frame = _frames[_currentFrame];
+    vkCmdWriteTimestamp(cb, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.queryPool, 2 * scope + 1);
+    frame.scopes[scope].ended = true;
+    _currentLevel--;
+}
+
+std::optional<GpuProfiler::Wrapper> GpuProfiler::WrapSubmission(
+    const char* name,
+    VkPipelineStageFlagBits beginStage
+)
+{
+    if (_frames.empty()) {
+        return std::nullopt;
+    }
+    FrameContext& frame = _frames[_currentFrame];
+    if (frame.numWrappers == MAX_WRAPPED_SUBMISSIONS || frame.scopes.size() == MAX_SCOPES) {
+        return std::nullopt;
+    }
+    Wrapper wrapper = frame.wrappers[frame.numWrappers++];
+    VkCommandBufferBeginInfo beginInfo{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+    VK_CHECK_RESULT(vkBeginCommandBuffer(wrapper.begin, &beginInfo));
+    ScopeId scope = beginScope(wrapper.begin, name, beginStage);
+    VK_CHECK_RESULT(vkEndCommandBuffer(wrapper.begin));
+
+    VK_CHECK_RESULT(vkBeginCommandBuffer(wrapper.end, &beginInfo));
+    End(wrapper.end, scope);
+    VK_CHECK_RESULT(vkEndCommandBuffer(wrapper.end));
+    return wrapper;
+}
+
+GpuProfiler::ScopeId GpuProfiler::beginScope(
+    VkCommandBuffer cb,
+    const char* name,
+    VkPipelineStageFlagBits stage
+)
+{
+    if (_frames.empty()) {
+        return INVALID_SCOPE;
+    }
+    FrameContext& frame = _frames[_currentFrame];
+    if (frame.scopes.size() == MAX_SCOPES) {
+        return INVALID_SCOPE;
+    }
+    ScopeId scope = frame.scopes.size();
+    frame.scopes.push_back({name, _currentLevel});
+    _currentLevel++;
+    vkCmdResetQueryPool(cb, frame.queryPool, 2 * scope, 2);
+    vkCmdWriteTimestamp(cb, stage, frame.queryPool, 2 * scope);
+    return scope;
+}
+
+void GpuProfiler::collect(FrameContext& frame, const ClockDomains& clockDomains, Profiler& profiler)
+{
+    uint32_t numQueries = 2 * frame.scopes.size();
+    if (numQueries == 0) {
+        return;
+    }
+    _results.resize(numQueries);
+    VkResult result = vkGetQueryPoolResults(
+        _device,
+        frame.queryPool,
+        0,
+        numQueries,
+        numQueries * sizeof(_results[0]),
+        _results.data(),
+        sizeof(_results[0]),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+    );
+    // VK_NOT_READY: some scope never got submitted, the others are still there
+    if (result != VK_SUCCESS && result != VK_NOT_READY) {
+        return;
+    }
+
+    // uncalibrated, only the durations are meaningful; line the scopes up from now on
+    Profiler::TimeUnit now = std::chrono::steady_clock::now();
+    uint64_t firstTicks = UINT64_MAX;
+    for (uint32_t i = 0; i < frame.scopes.size(); i++) {
+        if (_results[2 * i][1] != 0) {
+            firstTicks = std::min(firstTicks, _results[2 * i][0]);
+        }
+    }
+    auto sinceFirst = [&](uint64_t ticks) {
+        return now
+               + std::chrono::nanoseconds(static_cast<int64_t>(
+                   ((ticks - firstTicks) & _timestampMask) * _timestampPeriodNanoSeconds
+               ));
+    };
+
+    for (uint32_t i = 0; i < frame.scopes.size(); i++) {
+        const Scope& scope = frame.scopes[i];
+        const std::array<uint64_t, 2>& begin = _results[2 * i];
+        const std::array<uint64_t, 2>& end = _results[2 * i + 1];
+        if (!scope.ended || begin[1] == 0 || end[1] == 0) {
+            continue;
+        }
+        std::optional<ClockDomains::TimePoint> hostBegin = clockDomains.DeviceToHost(begin[0]);
+        std::optional<ClockDomains::TimePoint> hostEnd = clockDomains.DeviceToHost(end[0]);
+        if (!hostBegin.has_value() || !hostEnd.has_value()) {
+            hostBegin = sinceFirst(begin[0]);
+            hostEnd = sinceFirst(end[0]);
+        }
+        profiler.RecordGPU(
+            getEntryName(scope.name), hostBegin.value(), hostEnd.value(), scope.level
+        );
+    }
+}
+
+const char* GpuProfiler::getEntryName(const char* name)
+{
+    auto it = _entryNames.find(name);
+    if (it == _entryNames.end()) {
+        it = _entryNames.emplace(name, std::string("GPU: ") + name).first;
+    }
+    return it->second.c_str();
+}
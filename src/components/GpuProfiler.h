@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#include "ClockDomains.h"
+#include "Profiler.h"
+
+// Times named regions of command buffers with timestamp queries, the GPU side of `Profiler`.
+// Each frame in flight has its own query pool; `BeginFrame()` reads back what the frame
+// recorded last time around, once its fence has signaled, as "GPU: <name>" profiler entries.
+// Scopes nest like `PROFILE_SCOPE`s do, in the order they execute on the queue, and have to be
+// recorded outside of render passes.
+// Pre-recorded command buffers are timed by submitting them in between a `WrapSubmission()`.
+class GpuProfiler
+{
+  public:
+    using ScopeId = uint32_t;
+    static const ScopeId INVALID_SCOPE = UINT32_MAX; // unsupported, or out of queries
+
+    static const uint32_t MAX_SCOPES = 32; // per frame
+    static const uint32_t MAX_WRAPPED_SUBMISSIONS = 4;
+
+    // command buffers to submit right before & right after the timed ones
+    struct Wrapper
+    {
+        VkCommandBuffer begin;
+        VkCommandBuffer end;
+    };
+
+    // QUEUEFAMILYINDEX: of the queue the timed command buffers get submitted to,
+    // TIMESTAMPVALIDBITS its `timestampValidBits`; no timestamps get written if 0
+    void Init(
+        VkDevice device,
+        uint32_t queueFamilyIndex,
+        uint32_t timestampValidBits,
+        double timestampPeriodNanoSeconds,
+        uint32_t numFrames
+    );
+    void Cleanup();
+    bool IsSupported() const { return !_frames.empty(); }
+
+    // records FRAME's scopes from its last time around into PROFILER, then starts recording
+    // FRAME's; FRAME's fence must have signaled
+    void BeginFrame(uint32_t frame, const ClockDomains& clockDomains, Profiler& profiler);
+
+    // NAME must outlive the profiler, e.g. a string literal
+    ScopeId Begin(VkCommandBuffer cb, const char* name);
+    void End(VkCommandBuffer cb, ScopeId scope);
+
+    // a scope around what's submitted in between, e.g. a pre-recorded command buffer.
+    // BEGINSTAGE: where the begin timestamp gets written, past the submission's semaphore waits
+    // if it's the stage they block, so that the scope doesn't include the wait
+    std::optional<Wrapper> WrapSubmission(const char* name, VkPipelineStageFlagBits beginStage);
+
+  private:
+    struct Scope
+    {
+        const char* name;
+        int level;
+        bool ended = false;
+    };
+
+    struct FrameContext
+    {
+        VkQueryPool queryPool = VK_NULL_HANDLE; // scope i writes queries 2i & 2i + 1
+        VkCommandPool commandPool = VK_NULL_HANDLE; // of the wrappers, reset as a whole
+        std::array<Wrapper, MAX_WRAPPED_SUBMISSIONS> wrappers = {};
+        uint32_t numWrappers = 0; // recorded this time around
+        std::vector<Scope> scopes;
+    };
+
+    ScopeId beginScope(VkCommandBuffer cb, const char* name, VkPipelineStageFlagBits stage);
+    void collect(FrameContext& frame, const ClockDomains& clockDomains, Profiler& profiler);
+    // the profiler entry's name for scope NAME, kept alive for the profiler
+    const char* getEntryName(const char* name);
+
+    VkDevice _device = VK_NULL_HANDLE;
+    double _timestampPeriodNanoSeconds = 0;
+    uint64_t _timestampMask = 0;
+    std::vector<FrameContext> _frames; // empty when unsupported
+    uint32_t _currentFrame = 0;
+    int _currentLevel = 0;
+    std::unordered_map<const char*, std::string> _entryNames; // by scope name
+    std::vector<std::array<uint64_t, 2>> _results; // [timestamp, availability] per query
+};
@@ -0,0 +1,190 @@
+#include <algorithm>
+
+#include "LoadGenerator.h"
+
+namespace
+{
+// workers re-read the load & go idle at slice boundaries
+const std::chrono::microseconds SLICE(1000);
+// streamed at a time between clock reads
+const size_t MEMORY_CHUNK_BYTES = 64 * 1024;
+} // namespace
+
+void LoadGenerator::Init(uint32_t maxWorkers, size_t memoryBufferBytes)
+{
+    ASSERT(_workers.empty());
+    _memoryBufferBytes = std::max(memoryBufferBytes, MEMORY_CHUNK_BYTES);
+    _load = Load{};
+    _stop = false;
+    for (uint32_t i = 0; i < maxWorkers; i++) {
+        _workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+void LoadGenerator::Cleanup()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cvLoad.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void LoadGenerator::SetLoad(const Load& load)
+{
+    uint32_t maxWorkers = _workers.size();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _load = load;
+        _load.cpuThreads = std::min(load.cpuThreads, maxWorkers);
+        _load.memoryThreads = std::min(load.memoryThreads, maxWorkers - _load.cpuThreads);
+        _load.cpuDutyCycle = std::clamp(load.cpuDutyCycle, 0.f, 1.f);
+        _load.memoryDutyCycle = std::clamp(load.memoryDutyCycle, 0.f, 1.f);
+    }
+    _cvLoad.notify_all();
+}
+
+std::vector<LoadGenerator::SoakLevel> LoadGenerator::GetDefaultSoakScript(
+    double secondsPerLevel
+) const
+{
+    uint32_t all = _workers.size();
+    uint32_t half = std::max(all / 2, 1u);
+    return {
+        {"Idle", Load{}, secondsPerLevel},
+        {"CPU, half the cores", Load{.cpuThreads = half}, secondsPerLevel},
+        {"CPU, all cores", Load{.cpuThreads = all}, secondsPerLevel},
+        {"Memory, 1 thread", Load{.memoryThreads = 1}, secondsPerLevel},
+        {"Memory, half the cores", Load{.memoryThreads = half}, secondsPerLevel},
+        {"GPU, 4x draws", Load{.extraDrawInstances = 3}, secondsPerLevel},
+        {"GPU, 16x draws", Load{.extraDrawInstances = 15}, secondsPerLevel},
+        {"Combined",
+         Load{.cpuThreads = half, .memoryThreads = all - half, .extraDrawInstances = 15},
+         secondsPerLevel},
+    };
+}
+
+void LoadGenerator::StartSoak(const std::vector<SoakLevel>& script)
+{
+    _soakScript = script;
+    _soakLevel = 0;
+    _soakResults.clear();
+    _soakLevelStart = Clock::time_point{};
+}
+
+void LoadGenerator::StopSoak()
+{
+    if (!IsSoaking()) {
+        return;
+    }
+    if (_soakLevelStart != Clock::time_point{}) { // the level got cut short
+        _soakResults.pop_back();
+    }
+    _soakLevel = _soakScript.size();
+    SetLoad(Load{});
+}
+
+void LoadGenerator::OnFrame(bool parityMiss)
+{
+    if (!IsSoaking()) {
+        return;
+    }
+    Clock::time_point now = Clock::now();
+    const SoakLevel& level = _soakScript[_soakLevel];
+    if (_soakLevelStart == Clock::time_point{}) { // the frame the level's load got applied in
+        SetLoad(level.load);
+        _soakLevelStart = now;
+        _soakResults.push_back({.name = level.name, .load = _load});
+        return;
+    }
+    SoakResult& result = _soakResults.back();
+    result.numFrames++;
+    result.numDroppedFrames += parityMiss;
+    result.seconds = std::chrono::duration<double>(now - _soakLevelStart).count();
+    if (result.seconds >= level.seconds) {
+        finishSoakLevel();
+    }
+}
+
+void LoadGenerator::finishSoakLevel()
+{
+    const SoakResult& result = _soakResults.back();
+    INFO(
+        "Soak level {}/{} \"{}\": {} dropped frames in {} frames, {:.2f} per minute",
+        _soakLevel + 1,
+        _soakScript.size(),
+        result.name,
+        result.numDroppedFrames,
+        result.numFrames,
+        result.GetDropsPerMinute()
+    );
+    _soakLevel++;
+    _soakLevelStart = Clock::time_point{};
+    if (!IsSoaking()) {
+        SetLoad(Load{});
+    }
+}
+
+void LoadGenerator::workerLoop(uint32_t index)
+{
+    std::vector<uint64_t> buffer; // allocated once this worker first streams memory
+    size_t bufferPos = 0;
+    volatile uint64_t sink = index; // keeps the CPU load from being optimized out
+    while (true) {
+        Role role = Role::kIdle;
+        float dutyCycle = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cvLoad.wait(lock, [this, index, &role, &dutyCycle]() {
+                if (index < _load.cpuThreads) {
+                    role = Role::kCpu;
+                    dutyCycle = _load.cpuDutyCycle;
+                } else if (index < _load.cpuThreads + _load.memoryThreads) {
+                    role = Role::kMemory;
+                    dutyCycle = _load.memoryDutyCycle;
+                } else {
+                    role = Role::kIdle;
+                }
+                return _stop || role != Role::kIdle;
+            });
+            if (_stop) {
+                return;
+            }
+        }
+
+        Clock::time_point sliceBegin = Clock::now();
+        Clock::time_point busyEnd
+            = sliceBegin + std::chrono::duration_cast<Clock::duration>(SLICE * dutyCycle);
+        if (role == Role::kCpu) {
+            uint64_t state = sink;
+            while (Clock::now() < busyEnd) {
+                for (int i = 0; i < 1000; i++) { // LCG steps, dependent so they can't overlap
+                    state = state * 6364136223846793005ull + 1442695040888963407ull;
+                }
+            }
+            sink = state;
+        } else {
+            if (buffer.empty()) {
+                buffer.resize(_memoryBufferBytes / sizeof(uint64_t));
+            }
+            const size_t chunkSize = MEMORY_CHUNK_BYTES / sizeof(uint64_t);
+            while (Clock::now() < busyEnd) {
+                size_t end = std::min(bufferPos + chunkSize, buffer.size());
+                for (size_t i = bufferPos; i < end; i++) { // a read & a write per element
+                    buffer[i]++;
+                }
+                _numBytesStreamed.fetch_add(
+                    2 * (end - bufferPos) * sizeof(uint64_t), std::memory_order_relaxed
+                );
+                bufferPos = end == buffer.size() ? 0 : end;
+            }
+        }
+        if (dutyCycle < 1.f) {
+            std::this_thread::sleep_until(sliceBegin + SLICE);
+        }
+    }
+}
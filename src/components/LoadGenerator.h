@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Synthetic load to find out how much headroom the even-odd loop has:
+// - CPU: workers spinning on arithmetic, competing for cores with the render loop
+// - memory: workers streaming through buffers larger than the caches, competing for bandwidth
+// - GPU: extra instances of every scene draw, see `TickContext::extraDrawInstances`
+// Workers come from a pool of at most `Init()`'s MAXWORKERS threads, parked while idle, and
+// work in 1ms slices so that a duty cycle below 1 leaves gaps for the OS to schedule into.
+// A soak test steps through load levels and counts the parity misses at each.
+// `SetLoad()` & the soak are for the render thread; workers only read the load.
+class LoadGenerator
+{
+  public:
+    struct Load
+    {
+        uint32_t cpuThreads = 0;
+        float cpuDutyCycle = 1.f; // fraction of each slice spent busy
+        uint32_t memoryThreads = 0;
+        float memoryDutyCycle = 1.f;
+        uint32_t extraDrawInstances = 0;
+    };
+
+    struct SoakLevel
+    {
+        const char* name;
+        Load load;
+        double seconds;
+    };
+
+    struct SoakResult
+    {
+        const char* name;
+        Load load;
+        double seconds = 0;
+        uint64_t numFrames = 0;
+        uint64_t numDroppedFrames = 0;
+
+        double GetDropsPerMinute() const
+        {
+            return seconds == 0 ? 0 : numDroppedFrames * 60 / seconds;
+        }
+    };
+
+    // MEMORYBUFFERBYTES: streamed through by each memory worker, allocated on first use
+    void Init(uint32_t maxWorkers, size_t memoryBufferBytes);
+    void Cleanup(); // joins the workers
+
+    uint32_t GetMaxWorkers() const { return _workers.size(); }
+    void SetLoad(const Load& load); // thread counts get clamped to the pool together
+    const Load& GetLoad() const { return _load; }
+    uint64_t GetNumBytesStreamed() const { return _numBytesStreamed.load(); }
+
+    // a ramp of each kind of load on its own, then all of them combined
+    std::vector<SoakLevel> GetDefaultSoakScript(double secondsPerLevel) const;
+    void StartSoak(const std::vector<SoakLevel>& script);
+    void StopSoak(); // keeps the results of the levels completed so far
+    bool IsSoaking() const { return _soakLevel < _soakScript.size(); }
+    size_t GetSoakLevel() const { return _soakLevel; } // being run
+    size_t GetNumSoakLevels() const { return _soakScript.size(); }
+    const std::vector<SoakResult>& GetSoakResults() const { return _soakResults; }
+    // account for a frame while soaking; PARITYMISS: it showed the wrong color space
+    void OnFrame(bool parityMiss);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Role
+    {
+        kIdle,
+        kCpu,
+        kMemory,
+    };
+
+    void workerLoop(uint32_t index);
+    void finishSoakLevel();
+
+    std::vector<std::thread> _workers;
+    size_t _memoryBufferBytes = 0;
+    std::mutex _mutex;
+    std::condition_variable _cvLoad; // signaled on load changes & stop
+    Load _load;                      // guarded by `_mutex` for the workers
+    bool _stop = false;
+    std::atomic<uint64_t> _numBytesStreamed = 0;
+
+    std::vector<SoakLevel> _soakScript;
+    size_t _soakLevel = 0;
+    std::vector<SoakResult> _soakResults;
+    Clock::time_point _soakLevelStart; // epoch until the level's first frame
+};
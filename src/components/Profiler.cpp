@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "lib/Utils.h"
+
+#include "Profiler.h"
+
+#if PROFILER_TSC // defined by the header
+#include <cpuid.h>
+#endif
+
+namespace
+{
+// spent pairing the TSC with the steady clock at startup, the rate gets refined every tick after
+const std::chrono::milliseconds STARTUP_CALIBRATION(2);
+
+// whether the TSC ticks at a constant rate across cores, frequency changes & sleep states
+bool hasInvariantTSC()
+{
+#if PROFILER_TSC
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+} // namespace
+
+Profiler::Profiler()
+{
+    for (std::vector<Entry>& profile : _profiles) {
+        profile.reserve(MAX_ENTRIES);
+    }
+    _useTSC = hasInvariantTSC();
+    calibrate();
+    _firstTicks = _anchorTicks;
+    _firstTime = _anchorTime;
+    if (_useTSC) {
+        while (std::chrono::steady_clock::now() - _firstTime < STARTUP_CALIBRATION) {
+        }
+        calibrate();
+    }
+}
+
+Profiler::~Profiler()
+{
+    for (std::atomic<ThreadBuffer*>& buffer : _threads) {
+        delete buffer.load();
+    }
+}
+
+void Profiler::Record(const char* name, TimeUnit begin, TimeUnit end)
+{
+    ThreadBuffer* buffer = getThreadBuffer();
+    if (buffer != nullptr) {
+        RawEntry entry{
+            nullptr,
+            name,
+            static_cast<uint64_t>(begin.time_since_epoch().count()),
+            static_cast<uint64_t>(end.time_since_epoch().count()),
+            buffer->level,
+            false
+        };
+        complete(*buffer, entry);
+    }
+}
+
+void Profiler::RecordGPU(const char* name, TimeUnit begin, TimeUnit end, int level)
+{
+    ThreadBuffer* buffer = getThreadBuffer();
+    if (buffer != nullptr) {
+        RawEntry entry{
+            nullptr,
+            name,
+            static_cast<uint64_t>(begin.time_since_epoch().count()),
+            static_cast<uint64_t>(end.time_since_epoch().count()),
+            level,
+            true
+        };
+        complete(*buffer, entry);
+    }
+}
+
+const std::vector<Profiler::Entry>& Profiler::NewProfile()
+{
+    std::vector<Entry>& profile = _profiles[_currentProfile ^ 1];
+    profile.clear();
+    calibrate(); // the entries are at most a few ticks older than the pairing
+    uint32_t numThreads = std::min(_numThreads.load(std::memory_order_acquire), MAX_THREADS);
+    for (uint32_t i = 0; i < numThreads; i++) {
+        ThreadBuffer* buffer = _threads[i].load(std::memory_order_acquire);
+        if (buffer == nullptr) {
+            continue;
+        }
+        size_t first = profile.size();
+        while (std::optional<RawEntry> raw = buffer->completed.TryPop()) {
+            if (profile.size() == MAX_ENTRIES) { // drained all the same
+                _numMergeDrops++;
+                continue;
+            }
+            const RawEntry& entry = raw.value();
+            bool recorded = entry.scope == nullptr;
+            profile.push_back(Entry{
+                .name = recorded ? entry.name : entry.scope->name,
+                .begin = recorded ? TimeUnit(std::chrono::nanoseconds(entry.begin))
+                                  : toTime(entry.begin),
+                .end = recorded ? TimeUnit(std::chrono::nanoseconds(entry.end)) : toTime(entry.end),
+                .level = entry.level,
+                .gpu = entry.gpu,
+                .threadId = buffer->threadId,
+                .threadName = buffer->threadName.c_str(),
+                .scope = entry.scope
+            });
+        }
+        // completed innermost scope first, back into the order they began in
+        std::sort(profile.begin() + first, profile.end(), [](const Entry& a, const Entry& b) {
+            return a.begin < b.begin || (a.begin == b.begin && a.level < b.level);
+        });
+    }
+    _currentProfile ^= 1;
+    return profile;
+}
+
+uint64_t Profiler::GetNumDroppedEntries() const
+{
+    uint64_t numDropped = _numMergeDrops;
+    uint32_t numThreads = std::min(_numThreads.load(std::memory_order_acquire), MAX_THREADS);
+    for (uint32_t i = 0; i < numThreads; i++) {
+        ThreadBuffer* buffer = _threads[i].load(std::memory_order_acquire);
+        if (buffer != nullptr) {
+            numDropped += buffer->numDropped.load(std::memory_order_relaxed);
+        }
+    }
+    return numDropped;
+}
+
+Profiler::BenchmarkResult Profiler::Benchmark(uint32_t numScopes)
+{
+    using Clock = std::chrono::steady_clock;
+    const uint32_t batchSize = THREAD_BUFFER_CAPACITY / 2; // merged before the buffer fills up
+    BenchmarkResult result;
+    // the engine's profiler & threads keep their buffers to themselves
+    std::thread([&result, numScopes, batchSize]() {
+        Profiler profiler;
+        { PROFILE_SCOPE(&profiler, "Warm-up"); } // registers the thread
+        profiler.NewProfile();
+
+        uint32_t numBatches = std::max(numScopes / batchSize, 1u);
+        Clock::duration scopeTime{};
+        Clock::duration mergeTime{};
+        for (uint32_t batch = 0; batch < numBatches; batch++) {
+            Clock::time_point begin = Clock::now();
+            for (uint32_t i = 0; i < batchSize; i++) {
+                PROFILE_SCOPE(&profiler, "Benchmark");
+            }
+            Clock::time_point scopesEnd = Clock::now();
+            profiler.NewProfile();
+            mergeTime += Clock::now() - scopesEnd;
+            scopeTime += scopesEnd - begin;
+        }
+        double numEntries = static_cast<double>(numBatches) * batchSize;
+        result.scopeNanoSeconds = std::chrono::duration<double, std::nano>(scopeTime).count()
+                                  / numEntries;
+        result.mergeNanoSeconds = std::chrono::duration<double, std::nano>(mergeTime).count()
+                                  / numEntries;
+
+        volatile uint64_t sink = 0; // keeps the reads from being optimized out
+        Clock::time_point begin = Clock::now();
+        for (uint32_t i = 0; i < numBatches * batchSize; i++) {
+            sink = profiler.readClock();
+        }
+        (void)sink;
+        result.clockNanoSeconds
+            = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / numEntries;
+        result.tsc = profiler.IsClockTSC();
+    }).join();
+    return result;
+}
+
+Profiler::ThreadBuffer* Profiler::registerThread()
+{
+    uint32_t threadId = Utils::Thread::GetCurrentThreadId();
+    ThreadBuffer* buffer = nullptr;
+    // the thread may have registered before using another profiler in between
+    uint32_t numThreads = std::min(_numThreads.load(std::memory_order_acquire), MAX_THREADS);
+    for (uint32_t i = 0; i < numThreads && buffer == nullptr; i++) {
+        ThreadBuffer* other = _threads[i].load(std::memory_order_acquire);
+        if (other != nullptr && other->threadId == threadId) {
+            buffer = other;
+        }
+    }
+
+    uint32_t slot = buffer == nullptr ? _numThreads.fetch_add(1, std::memory_order_relaxed) : 0;
+    if (buffer == nullptr && slot < MAX_THREADS) {
+        buffer = new ThreadBuffer();
+        buffer->threadId = threadId;
+        buffer->threadName = Utils::Thread::GetCurrentThreadName();
+        if (buffer->threadName.empty()) {
+            buffer->threadName = "Thread " + std::to_string(threadId);
+        }
+        _threads[slot].store(buffer, std::memory_order_release);
+    }
+    s_threadCache = {_id, buffer};
+    return buffer;
+}
+
+void Profiler::calibrate()
+{
+    // the steady clock read in between two reads of the clock, paired with their midpoint
+    uint64_t before = readClock();
+    TimeUnit time = std::chrono::steady_clock::now();
+    uint64_t after = readClock();
+    _anchorTicks = before + (after - before) / 2;
+    _anchorTime = time;
+    if (!_useTSC) { // ticks are the steady clock's nanoseconds already
+        return;
+    }
+    // the longer the baseline the finer the rate, the latest pairing takes care of any offset
+    if (_firstTime != TimeUnit{} && _anchorTicks > _firstTicks && _anchorTime > _firstTime) {
+        _nanoSecondsPerTick = (_anchorTime - _firstTime).count()
+                              / static_cast<double>(_anchorTicks - _firstTicks);
+    }
+}
+
+Profiler::TimeUnit Profiler::toTime(uint64_t ticks) const
+{
+    double ticksSinceAnchor = static_cast<double>(static_cast<int64_t>(ticks - _anchorTicks));
+    return _anchorTime
+           + std::chrono::nanoseconds(std::llround(ticksSinceAnchor * _nanoSecondsPerTick));
+}
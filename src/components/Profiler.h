@@ -1,21 +1,44 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "SPSCQueue.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PROFILER_TSC 1
+#include <x86intrin.h>
+#else
+#define PROFILER_TSC 0
+#endif
+
 // inspired by cgc profiler
 
-// Scope-based profiler utility that records time and 
+// Scope-based profiler utility that records time and
 // call hierarchy information for subroutines.
+// Any thread may profile: each one gets a buffer of its own on its first scope, filled without
+// locks, and `NewProfile()` merges the buffers at the end of every tick.
+// Cheap enough to stay on: scopes are described at compile time, time the invariant TSC where
+// there is one, and nothing gets allocated past a thread's first scope.
 class Profiler
 {
   public:
-#ifdef __linux__
-    using TimeUnit = std::chrono::time_point<
-    std::chrono::system_clock,
-    std::chrono::duration<long, std::ratio<1, 1000000000>>>;
-#else 
+    // the steady clock, which `ClockDomains` converts GPU & present timestamps to
     using TimeUnit = std::chrono::time_point<
     std::chrono::steady_clock,
     std::chrono::duration<long, std::ratio<1, 1000000000>>>;
-#endif
+
+    // one per `PROFILE_SCOPE`, with static storage
+    struct ScopeDescriptor
+    {
+        const char* name;
+        const char* file;
+        uint32_t line;
+    };
 
     struct Profling
     {
@@ -23,8 +46,8 @@ class Profiler
         int id;
         Profling() = delete;
 
-        Profling(Profiler* parent, const char* name) : parent(parent) {
-            id = parent->Push(name);
+        Profling(Profiler* parent, const ScopeDescriptor* scope) : parent(parent) {
+            id = parent->Push(scope);
         }
 
         ~Profling() { parent->Pop(id); }
@@ -35,55 +58,191 @@ class Profiler
         const char* name;
         TimeUnit begin;
         TimeUnit end;
-        int level;
+        int level; // among the entries of its thread
+        bool gpu = false; // measured on the GPU, nested among the GPU entries only
+        uint32_t threadId = 0; // OS id of the thread that measured it
+        const char* threadName = nullptr; // lives as long as the profiler
+        const ScopeDescriptor* scope = nullptr; // of its `PROFILE_SCOPE`, nullptr if recorded
+    };
+
+    // the cost of profiling, see `Benchmark()`
+    struct BenchmarkResult
+    {
+        double scopeNanoSeconds = 0; // to push & pop an empty scope
+        double clockNanoSeconds = 0; // to read the clock, twice per scope
+        double mergeNanoSeconds = 0; // per entry, in `NewProfile()`
+        bool tsc = false;            // whether the clock is the TSC
     };
 
-    Profiler() {
-        _currEntryLevel = 0;
-        _profileData = std::make_unique<std::vector<Profiler::Entry>>();
+    static const uint32_t MAX_THREADS = 64; // scopes of any more threads get dropped
+    static const int MAX_DEPTH = 32;        // deeper scopes get dropped
+    static const size_t MAX_ENTRIES = 4096; // per profile, the rest get dropped
+
+    // calibrates the TSC against the steady clock for a couple milliseconds
+    Profiler();
+    ~Profiler(); // no thread may be profiling anymore
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // begin a scope on the calling thread, returns its id for `Pop()`
+    int Push(const ScopeDescriptor* scope)
+    {
+        ThreadBuffer* buffer = getThreadBuffer();
+        if (buffer == nullptr) {
+            return 0;
+        }
+        int level = buffer->level++;
+        if (level < MAX_DEPTH) {
+            RawEntry& entry = buffer->openEntries[level];
+            entry.scope = scope;
+            entry.level = level;
+            entry.begin = readClock();
+        }
+        return level;
+    }
+
+    void Pop(int entryId)
+    {
+        ThreadBuffer* buffer = getThreadBuffer();
+        if (buffer == nullptr) {
+            return;
+        }
+        uint64_t end = readClock();
+        buffer->level--;
+        if (entryId >= MAX_DEPTH) {
+            buffer->numDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        RawEntry entry = buffer->openEntries[entryId];
+        entry.end = end;
+        complete(*buffer, entry);
     }
 
+    // Record an entry measured elsewhere, nested in the calling thread's open scopes;
+    // NAME must outlive the profiler
+    void Record(const char* name, TimeUnit begin, TimeUnit end);
+    // Record a GPU entry, LEVEL deep among the frame's GPU entries, see `GpuProfiler`
+    void RecordGPU(const char* name, TimeUnit begin, TimeUnit end, int level);
 
-    int Push(const char* name) {
-        Entry entry;
-        entry.name = name;
-        entry.begin = std::chrono::high_resolution_clock::now();
-        entry.level = _currEntryLevel;
+    // Clears all entries that has been profiled,
+    // returns all entries that has been profiled. should be called every Tick.
+    // Entries are grouped by thread, in the order their scopes began;
+    // scopes still open on other threads end up in a later profile.
+    // The profile stays valid until the next call, which reuses the one before it.
+    // Only ever called from one thread.
+    const std::vector<Profiler::Entry>& NewProfile();
 
-        _profileData->push_back(entry);
+    // entries dropped for lack of room, see the limits above
+    uint64_t GetNumDroppedEntries() const;
+    bool IsClockTSC() const { return _useTSC; }
 
-        int entryId = _profileData->size() - 1;
-        _currEntryLevel++;
-        return entryId;
+    // profiles NUMSCOPES empty scopes with a profiler and a thread of their own
+    static BenchmarkResult Benchmark(uint32_t numScopes);
+
+  private:
+    static const size_t THREAD_BUFFER_CAPACITY = 1024; // entries
+
+    struct RawEntry
+    {
+        const ScopeDescriptor* scope; // nullptr if recorded
+        const char* name;             // of a recorded entry
+        uint64_t begin; // clock ticks, or nanoseconds of the steady clock if recorded
+        uint64_t end;
+        int level;
+        bool gpu;
+    };
+
+    // written by its thread only, except for the consumer end of `completed`
+    struct ThreadBuffer
+    {
+        uint32_t threadId;
+        std::string threadName;
+        std::array<RawEntry, MAX_DEPTH> openEntries; // by level
+        int level = 0;
+        SPSCQueue<RawEntry, THREAD_BUFFER_CAPACITY> completed; // -> `NewProfile()`
+        std::atomic<uint64_t> numDropped = 0;
+    };
+
+    // the calling thread's buffer of the last profiler it used, zero-initialized
+    struct ThreadCache
+    {
+        uint64_t profilerId;
+        ThreadBuffer* buffer;
+    };
+
+    uint64_t readClock() const
+    {
+#if PROFILER_TSC
+        if (_useTSC) {
+            return __rdtsc();
+        }
+#endif
+        return std::chrono::steady_clock::now().time_since_epoch().count();
     }
 
-    void Pop(int entryId) {
-        Entry& entry = _profileData->at(entryId);
-        entry.end = std::chrono::high_resolution_clock::now();
-        _currEntryLevel--;
+    // of the calling thread, registered on first use; nullptr past MAX_THREADS
+    ThreadBuffer* getThreadBuffer()
+    {
+        if (s_threadCache.profilerId == _id) {
+            return s_threadCache.buffer;
+        }
+        return registerThread();
     }
 
-    // Clears all entries that has been profiled, 
-    // returns all entries that has been profiled. should be called every Tick
-    std::unique_ptr<std::vector<Profiler::Entry>> NewProfile() {
-        _currEntryLevel = 0;
-        auto lastProfileData = std::move(_profileData);
-        _profileData = std::make_unique<std::vector<Profiler::Entry>>();
-        return lastProfileData;
+    ThreadBuffer* registerThread();
+
+    void complete(ThreadBuffer& buffer, const RawEntry& entry)
+    {
+        if (!buffer.completed.TryPush(entry)) {
+            buffer.numDropped.fetch_add(1, std::memory_order_relaxed);
+        }
     }
 
-  private:
-    int _currEntryLevel = 0;
-    std::unique_ptr<std::vector<Profiler::Entry>> _profileData;
+    // pair the clock with the steady clock, refining the TSC's rate
+    void calibrate();
+    TimeUnit toTime(uint64_t ticks) const;
+
+    static inline std::atomic<uint64_t> s_nextId = 1;
+    static inline thread_local ThreadCache s_threadCache;
+    const uint64_t _id = s_nextId.fetch_add(1); // outlives the profiler's address
+
+    // registered in slot order; a slot may still be null while its thread registers
+    std::array<std::atomic<ThreadBuffer*>, MAX_THREADS> _threads = {};
+    std::atomic<uint32_t> _numThreads = 0; // slots taken, may exceed MAX_THREADS
+
+    // double-buffered, the one not handed out gets merged into
+    std::array<std::vector<Entry>, 2> _profiles;
+    uint32_t _currentProfile = 0;
+    uint64_t _numMergeDrops = 0;
+
+    bool _useTSC = false;
+    double _nanoSecondsPerTick = 1;
+    // the first & the latest pairing of the clocks
+    uint64_t _firstTicks = 0;
+    TimeUnit _firstTime;
+    uint64_t _anchorTicks = 0;
+    TimeUnit _anchorTime;
 };
 
 // profiler macros
 
 #define USE_PROFILER
 
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
 #ifdef USE_PROFILER
-#define PROFILE_SCOPE(profiler, name)                                          \
-    const auto __profling = Profiler::Profling(profiler, name);
+// NAME: a string literal
+#define PROFILE_SCOPE(profiler, name)                                                              \
+    static constexpr Profiler::ScopeDescriptor PROFILER_CONCAT(__profilerScope, __LINE__){         \
+        name, __FILE__, __LINE__                                                                   \
+    };                                                                                             \
+    PROFILE_SCOPE_DESCRIPTOR(profiler, PROFILER_CONCAT(__profilerScope, __LINE__))
+// DESCRIPTOR: a `Profiler::ScopeDescriptor` with static storage, e.g. one of several picked at
+// runtime
+#define PROFILE_SCOPE_DESCRIPTOR(profiler, descriptor)                                             \
+    const auto PROFILER_CONCAT(__profling, __LINE__) = Profiler::Profling(profiler, &(descriptor));
 #else
-#define PROFILE_SCOPE(profiler) (0)
+#define PROFILE_SCOPE(profiler, name)
+#define PROFILE_SCOPE_DESCRIPTOR(profiler, descriptor)
 #endif
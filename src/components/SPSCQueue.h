@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Neither side ever blocks; `TryPush()` fails when the queue is full.
+template <typename T, size_t CAPACITY>
+class SPSCQueue
+{
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "capacity must be a power of 2");
+
+  public:
+    // producer only; false if the queue is full, in which case ITEM is left untouched
+    bool TryPush(T&& item)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        _slots[tail & (CAPACITY - 1)] = std::move(item);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPush(const T& item)
+    {
+        T copy = item;
+        return TryPush(std::move(copy));
+    }
+
+    // consumer only; `std::nullopt` if the queue is empty
+    std::optional<T> TryPop()
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> item = std::move(_slots[head & (CAPACITY - 1)]);
+        _head.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+  private:
+    std::array<T, CAPACITY> _slots;
+    // monotonically increasing indices, on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> _head = 0; // next slot to pop, written by the consumer
+    alignas(64) std::atomic<size_t> _tail = 0; // next slot to push, written by the producer
+};
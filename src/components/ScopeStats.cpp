@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <bit>
+
+#include "ScopeStats.h"
+
+namespace
+{
+const std::array<double, 3> PERCENTILES = {0.50, 0.95, 0.99};
+} // namespace
+
+void ScopeStats::Init()
+{
+    _scopes.resize(MAX_SCOPES);
+    _summaries.reserve(MAX_SCOPES);
+    Reset();
+}
+
+void ScopeStats::Reset()
+{
+    _numScopes = 0;
+    _numUntrackedEntries = 0;
+    _currentSlice = 0;
+    _numCompletedSlices = 0;
+    _sliceStart = std::chrono::steady_clock::now();
+    _summaries.clear();
+}
+
+void ScopeStats::AddProfile(
+    const std::vector<Profiler::Entry>& profile,
+    int64_t budgetNanoSeconds
+)
+{
+    ASSERT(!_scopes.empty());
+    advance(std::chrono::steady_clock::now());
+    for (const Profiler::Entry& entry : profile) {
+        Scope* scope = findScope(entry.name, entry.gpu);
+        if (scope == nullptr) {
+            _numUntrackedEntries++;
+            continue;
+        }
+        int64_t nanoSeconds = std::chrono::nanoseconds(entry.end - entry.begin).count();
+        Slice& slice = scope->slices[_currentSlice];
+        slice.counts[bucketIndex(nanoSeconds)]++;
+        slice.count++;
+        slice.maxNanoSeconds = std::max(slice.maxNanoSeconds, nanoSeconds);
+        slice.numOverBudget += budgetNanoSeconds > 0 && nanoSeconds > budgetNanoSeconds;
+    }
+}
+
+uint32_t ScopeStats::bucketIndex(int64_t nanoSeconds)
+{
+    uint64_t value = std::clamp<int64_t>(nanoSeconds, 0, (1ll << MAX_VALUE_BITS) - 1);
+    if (value < SUB_BUCKETS) {
+        return value;
+    }
+    // the top SUB_BUCKET_BITS + 1 bits, the highest of which picks the power of two
+    uint32_t shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + (value >> shift) - SUB_BUCKETS;
+}
+
+int64_t ScopeStats::bucketUpperBound(uint32_t index)
+{
+    uint32_t powerOfTwo = index / SUB_BUCKETS;
+    if (powerOfTwo == 0) {
+        return index;
+    }
+    uint32_t shift = powerOfTwo - 1;
+    int64_t subBucket = index % SUB_BUCKETS + SUB_BUCKETS;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+ScopeStats::Scope* ScopeStats::findScope(const char* name, bool gpu)
+{
+    for (uint32_t i = 0; i < _numScopes; i++) {
+        if (_scopes[i].name == name && _scopes[i].gpu == gpu) {
+            return &_scopes[i];
+        }
+    }
+    if (_numScopes == MAX_SCOPES) {
+        return nullptr;
+    }
+    Scope& scope = _scopes[_numScopes++];
+    scope.name = name;
+    scope.gpu = gpu;
+    for (Slice& slice : scope.slices) {
+        slice = Slice{}; // zeroes the counts
+    }
+    return &scope;
+}
+
+void ScopeStats::advance(TimePoint now)
+{
+    if (now - _sliceStart < SLICE_DURATION) {
+        return;
+    }
+    // slices that passed without a tick, e.g. while paused, stay empty
+    auto numEnded = (now - _sliceStart) / SLICE_DURATION;
+    uint32_t numCleared = std::min<int64_t>(numEnded, NUM_SLICES);
+    for (uint32_t i = 0; i < numCleared; i++) {
+        _currentSlice = (_currentSlice + 1) % NUM_SLICES;
+        for (uint32_t s = 0; s < _numScopes; s++) {
+            _scopes[s].slices[_currentSlice] = Slice{};
+        }
+    }
+    _sliceStart += numEnded * SLICE_DURATION;
+    _numCompletedSlices
+        = std::min<uint64_t>(_numCompletedSlices + numEnded, NUM_COMPLETED_SLICES);
+    summarize();
+}
+
+void ScopeStats::summarize()
+{
+    _summaries.resize(_numScopes);
+    for (uint32_t s = 0; s < _numScopes; s++) {
+        const Scope& scope = _scopes[s];
+        Summary& summary = _summaries[s];
+        summary.name = scope.name;
+        summary.gpu = scope.gpu;
+        for (uint32_t w = 0; w < NUM_WINDOWS; w++) {
+            WindowStats& stats = summary.windows[w];
+            stats = WindowStats{};
+            _merged.fill(0);
+            uint32_t numSlices = std::min(WINDOW_SLICES[w], _numCompletedSlices);
+            for (uint32_t i = 1; i <= numSlices; i++) { // the current slice is still filling
+                const Slice& slice = scope.slices[(_currentSlice + NUM_SLICES - i) % NUM_SLICES];
+                if (slice.count == 0) {
+                    continue;
+                }
+                for (uint32_t b = 0; b < NUM_BUCKETS; b++) {
+                    _merged[b] += slice.counts[b];
+                }
+                stats.count += slice.count;
+                stats.maxNanoSeconds = std::max(stats.maxNanoSeconds, slice.maxNanoSeconds);
+                stats.numOverBudget += slice.numOverBudget;
+            }
+            if (stats.count == 0) {
+                continue;
+            }
+
+            std::array<int64_t*, PERCENTILES.size()> results
+                = {&stats.p50NanoSeconds, &stats.p95NanoSeconds, &stats.p99NanoSeconds};
+            uint32_t p = 0;
+            uint64_t numBelow = 0;
+            for (uint32_t b = 0; b < NUM_BUCKETS && p < PERCENTILES.size(); b++) {
+                numBelow += _merged[b];
+                // the first bucket reaching the percentile's rank, capped by the exact max
+                while (p < PERCENTILES.size() && numBelow >= PERCENTILES[p] * stats.count) {
+                    *results[p++] = std::min(bucketUpperBound(b), stats.maxNanoSeconds);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Profiler.h"
+
+// Rolling percentiles of every profiler scope's time, for the tail latency a per-frame plot
+// hides; the tail is what makes frames miss their parity.
+// Times are counted into log-linear (HDR-style) histograms: every power of two is split into
+// `SUB_BUCKETS` linear buckets, so percentiles are within ~3% of the actual times.
+// Each scope keeps a ring of one-second slices, the oldest one cleared as time moves on;
+// windows cover the most recent completed slices, summarized whenever a slice completes.
+// Storage is allocated once in `Init()`; recording never allocates. Used from a single thread.
+class ScopeStats
+{
+  public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    static const uint32_t MAX_SCOPES = 32; // any further scopes go untracked
+    static const uint32_t NUM_COMPLETED_SLICES = 10; // kept, the longest window
+    static constexpr std::chrono::seconds SLICE_DURATION{1};
+    // slices per window, the most recent completed ones
+    static constexpr std::array<uint32_t, 2> WINDOW_SLICES = {1, NUM_COMPLETED_SLICES};
+    static const uint32_t NUM_WINDOWS = WINDOW_SLICES.size();
+
+    struct WindowStats
+    {
+        uint64_t count = 0; // times the scope ran
+        int64_t p50NanoSeconds = 0;
+        int64_t p95NanoSeconds = 0;
+        int64_t p99NanoSeconds = 0;
+        int64_t maxNanoSeconds = 0; // exact, unlike the percentiles
+        uint64_t numOverBudget = 0; // runs longer than the budget they ran with
+    };
+
+    struct Summary
+    {
+        const char* name;
+        bool gpu;
+        std::array<WindowStats, NUM_WINDOWS> windows; // by `WINDOW_SLICES`
+    };
+
+    void Init();
+    void Reset(); // forget all scopes
+
+    // PROFILE: a tick's entries, e.g. from `Profiler::NewProfile()`;
+    // BUDGETNANOSECONDS: e.g. the display's refresh period, 0 if unknown
+    void AddProfile(const std::vector<Profiler::Entry>& profile, int64_t budgetNanoSeconds);
+
+    // as of the last completed slice, in the order the scopes first ran
+    const std::vector<Summary>& GetSummaries() const { return _summaries; }
+    uint64_t GetNumUntrackedEntries() const { return _numUntrackedEntries; }
+
+  private:
+    static const uint32_t NUM_SLICES = NUM_COMPLETED_SLICES + 1; // and the one being filled
+    static const uint32_t SUB_BUCKET_BITS = 5;
+    static const uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const uint32_t MAX_VALUE_BITS = 30; // ~1s, longer times land in the last bucket
+    static const uint32_t NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    struct Slice
+    {
+        std::array<uint32_t, NUM_BUCKETS> counts;
+        uint64_t count;
+        int64_t maxNanoSeconds;
+        uint64_t numOverBudget;
+    };
+
+    struct Scope
+    {
+        const char* name;
+        bool gpu;
+        std::array<Slice, NUM_SLICES> slices; // ring, the current one being filled
+    };
+
+    static uint32_t bucketIndex(int64_t nanoSeconds);
+    static int64_t bucketUpperBound(uint32_t index); // the longest time counted into it
+
+    // by pointer since scope names are literals or interned; nullptr if the table is full
+    Scope* findScope(const char* name, bool gpu);
+    void advance(TimePoint now); // complete the slices that ended by NOW
+    void summarize();            // the completed slices into `_summaries`
+
+    std::vector<Scope> _scopes; // the first `_numScopes` in use
+    uint32_t _numScopes = 0;
+    uint64_t _numUntrackedEntries = 0;
+    uint32_t _currentSlice = 0;
+    uint32_t _numCompletedSlices = 0; // up to `NUM_COMPLETED_SLICES`
+    TimePoint _sliceStart;
+    std::vector<Summary> _summaries;
+    std::array<uint64_t, NUM_BUCKETS> _merged; // a window's counts, while summarizing
+};
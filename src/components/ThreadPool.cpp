@@ -0,0 +1,68 @@
+#include "lib/Utils.h"
+
+#include "ThreadPool.h"
+
+void ThreadPool::Init(size_t numThreads)
+{
+    ASSERT(_workers.empty());
+    _stop = false;
+    for (size_t i = 0; i < numThreads; i++) {
+        _workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+void ThreadPool::Push(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_back(std::move(task));
+        _numPending++;
+    }
+    _cvTask.notify_one();
+}
+
+void ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cvIdle.wait(lock, [this]() { return _numPending == 0; });
+}
+
+void ThreadPool::Cleanup()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        _numPending -= _queue.size();
+        _queue.clear();
+    }
+    _cvTask.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void ThreadPool::workerLoop()
+{
+    Utils::Thread::SetCurrentThreadName("tetrium-worker"); // e.g. its track in the profiler
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cvTask.wait(lock, [this]() { return _stop || !_queue.empty(); });
+            if (_stop) {
+                return;
+            }
+            task = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _numPending--;
+            if (_numPending == 0) {
+                _cvIdle.notify_all();
+            }
+        }
+    }
+}
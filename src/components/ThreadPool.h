@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Fixed-size pool of worker threads executing fire-and-forget tasks.
+// The owner pushes a batch of tasks then blocks on `Wait()` for the whole batch to finish.
+class ThreadPool
+{
+  public:
+    // spawn NUMTHREADS workers
+    void Init(size_t numThreads);
+
+    // queue a task for any idle worker to pick up
+    void Push(std::function<void()> task);
+
+    // block until every task pushed so far has finished executing
+    void Wait();
+
+    // join all workers; tasks still queued are dropped
+    void Cleanup();
+
+    size_t GetNumThreads() const { return _workers.size(); }
+
+  private:
+    void workerLoop();
+
+    std::vector<std::thread> _workers;
+    std::deque<std::function<void()>> _queue;
+    std::mutex _mutex;
+    std::condition_variable _cvTask; // signaled on new task / stop
+    std::condition_variable _cvIdle; // signaled when the last pending task finishes
+    size_t _numPending = 0;          // tasks queued or executing
+    bool _stop = false;
+};
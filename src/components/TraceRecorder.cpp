@@ -0,0 +1,157 @@
+#include <chrono>
+#include <iomanip>
+
+#include "lib/Utils.h"
+
+#include "TraceRecorder.h"
+
+namespace
+{
+// the writer sleeps in between draining the queue, which holds ~1s worth of a busy frame's entries
+const std::chrono::milliseconds WRITER_PERIOD(10);
+
+// NAME as a JSON string
+void writeString(std::ofstream& file, const char* name)
+{
+    file << '"';
+    for (const char* c = name; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            file << '\\';
+        }
+        file << *c;
+    }
+    file << '"';
+}
+} // namespace
+
+bool TraceRecorder::Start(const std::string& path)
+{
+    Stop();
+    _file.open(path, std::ios::trunc);
+    if (!_file.is_open()) {
+        return false;
+    }
+    _path = path;
+    _file << std::fixed << std::setprecision(3); // microsecond timestamps, to the nanosecond
+    _file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    _firstEvent = true;
+    _start = std::chrono::steady_clock::now();
+    if (!_queue) {
+        _queue = std::make_unique<SPSCQueue<Event, QUEUE_CAPACITY>>();
+    }
+    _stop = false;
+    _numEventsWritten = 0;
+    _numEventsDropped = 0;
+    _threadNames.clear();
+    _writer = std::thread([this]() { writerLoop(); });
+    return true;
+}
+
+void TraceRecorder::Stop()
+{
+    if (!IsRecording()) {
+        return;
+    }
+    _stop = true;
+    _writer.join();
+    // metadata may come anywhere in the trace
+    for (const auto& [threadId, name] : _threadNames) {
+        writeThreadName(threadId, name);
+    }
+    writeThreadName(GPU_THREAD_ID, "GPU");
+    _file << "\n]}\n";
+    _file.close();
+    INFO(
+        "Trace recorded to {}: {} events, {} dropped",
+        _path,
+        _numEventsWritten.load(),
+        _numEventsDropped
+    );
+}
+
+void TraceRecorder::SubmitTick(
+    const std::vector<Profiler::Entry>& profile,
+    uint64_t tick,
+    bool parityMiss
+)
+{
+    if (!IsRecording()) {
+        return;
+    }
+    for (const Profiler::Entry& entry : profile) {
+        if (!entry.gpu && !_threadNames.contains(entry.threadId)) {
+            _threadNames[entry.threadId] = entry.threadName;
+        }
+        Event event{
+            .name = entry.name,
+            .begin = entry.begin,
+            .end = entry.end,
+            .tick = tick,
+            .threadId = entry.gpu ? GPU_THREAD_ID : entry.threadId,
+            .level = entry.level,
+            .instant = false
+        };
+        _numEventsDropped += !_queue->TryPush(std::move(event));
+    }
+    if (parityMiss) { // the tick that sampled the wrong parity ends about now
+        Profiler::TimeUnit now = std::chrono::steady_clock::now();
+        Event event{
+            .name = "Parity Miss",
+            .begin = now,
+            .end = now,
+            .tick = tick,
+            .threadId = Utils::Thread::GetCurrentThreadId(),
+            .level = 0,
+            .instant = true
+        };
+        _numEventsDropped += !_queue->TryPush(std::move(event));
+    }
+}
+
+void TraceRecorder::writerLoop()
+{
+    Utils::Thread::SetCurrentThreadName("tetrium-trace");
+    while (true) {
+        bool stopping = _stop.load(); // before the last drain, which then catches everything
+        while (std::optional<Event> event = _queue->TryPop()) {
+            writeEvent(event.value());
+            _numEventsWritten.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (stopping) {
+            return;
+        }
+        std::this_thread::sleep_for(WRITER_PERIOD);
+    }
+}
+
+void TraceRecorder::beginEvent()
+{
+    _file << (_firstEvent ? "\n" : ",\n");
+    _firstEvent = false;
+}
+
+void TraceRecorder::writeEvent(const Event& event)
+{
+    double timestamp = std::chrono::duration<double, std::micro>(event.begin - _start).count();
+    beginEvent();
+    _file << "{\"name\":";
+    writeString(_file, event.name);
+    _file << ",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":" << timestamp;
+    if (event.instant) {
+        _file << ",\"ph\":\"i\",\"s\":\"g\",\"args\":{\"tick\":" << event.tick << "}}";
+        return;
+    }
+    double duration = std::chrono::duration<double, std::micro>(event.end - event.begin).count();
+    _file << ",\"ph\":\"X\",\"dur\":" << duration << ",\"cat\":\""
+          << (event.threadId == GPU_THREAD_ID ? "gpu" : "cpu") << "\",\"args\":{\"tick\":"
+          << event.tick << ",\"level\":" << event.level << "}}";
+}
+
+void TraceRecorder::writeThreadName(uint32_t threadId, const std::string& name)
+{
+    beginEvent();
+    _file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+          << ",\"args\":{\"name\":";
+    writeString(_file, name.c_str());
+    _file << "}}";
+}
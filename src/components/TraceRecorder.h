@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Profiler.h"
+#include "SPSCQueue.h"
+
+// Streams profiler entries into a Chrome trace (JSON) file, for a look at a whole session in
+// chrome://tracing or https://ui.perfetto.dev, e.g. at the hitches around dropped frames.
+// The thread submitting the ticks only copies their entries into a queue, a writer thread
+// formats them & writes them out; entries that don't fit into the queue get dropped and counted.
+// Each profiled thread gets a track of its own, GPU entries another one;
+// parity misses show up as instant events.
+class TraceRecorder
+{
+  public:
+    // false if PATH can't be opened for writing; stops the running recording first
+    bool Start(const std::string& path);
+    void Stop(); // drains the queue & completes the file
+    bool IsRecording() const { return _writer.joinable(); }
+    const std::string& GetPath() const { return _path; } // of the last recording
+    uint64_t GetNumEventsWritten() const { return _numEventsWritten.load(); }
+    uint64_t GetNumEventsDropped() const { return _numEventsDropped; }
+
+    // queue tick TICK's PROFILE, e.g. from `Profiler::NewProfile()`; no-op unless recording.
+    // PARITYMISS: the tick showed the wrong color space.
+    // Only ever called from the thread that starts & stops the recording
+    void SubmitTick(const std::vector<Profiler::Entry>& profile, uint64_t tick, bool parityMiss);
+
+  private:
+    static const size_t QUEUE_CAPACITY = 1 << 14;
+    static const uint32_t GPU_THREAD_ID = 0; // no OS thread's
+
+    struct Event
+    {
+        const char* name;
+        Profiler::TimeUnit begin;
+        Profiler::TimeUnit end;
+        uint64_t tick;
+        uint32_t threadId;
+        int level;
+        bool instant; // a point in time at `begin`
+    };
+
+    void writerLoop();
+    void writeEvent(const Event& event);
+    void writeThreadName(uint32_t threadId, const std::string& name);
+    void beginEvent(); // separates the events
+
+    std::string _path;
+    std::ofstream _file; // the writer's while recording
+    bool _firstEvent = true;
+    Profiler::TimeUnit _start; // time 0 of the trace
+
+    std::unique_ptr<SPSCQueue<Event, QUEUE_CAPACITY>> _queue; // submitting thread -> writer
+    std::thread _writer;
+    std::atomic<bool> _stop = false;
+    std::atomic<uint64_t> _numEventsWritten = 0;
+    uint64_t _numEventsDropped = 0;
+    std::map<uint32_t, std::string> _threadNames; // tracks of the profiled threads
+};
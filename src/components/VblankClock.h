@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+// When the last vblank happened, published by a single thread observing vblanks.
+// Reads are lock-free through a seqlock; `WaitForVblankAfter()` blocks until the next publish.
+class VblankClock
+{
+  public:
+    struct Sample
+    {
+        uint64_t counter; // vblank counter after the vblank
+        std::chrono::steady_clock::time_point time;
+    };
+
+    // publisher only
+    void Publish(const Sample& sample)
+    {
+        uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed); // odd: publish in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        _counter.store(sample.counter, std::memory_order_relaxed);
+        _timeSinceEpoch.store(sample.time.time_since_epoch().count(), std::memory_order_relaxed);
+        _sequence.store(sequence + 2, std::memory_order_release);
+        { // waiters check under the lock, a notify can't slip in between their check and wait
+            std::lock_guard<std::mutex> lock(_mutex);
+        }
+        _cvPublished.notify_all();
+    }
+
+    // `std::nullopt` until the first vblank
+    std::optional<Sample> Read() const
+    {
+        while (true) {
+            uint64_t sequence = _sequence.load(std::memory_order_acquire);
+            if (sequence == 0) {
+                return std::nullopt;
+            }
+            if (sequence & 1) { // the publisher is mid-write, which takes a few stores
+                continue;
+            }
+            uint64_t counter = _counter.load(std::memory_order_relaxed);
+            std::chrono::steady_clock::duration timeSinceEpoch(
+                _timeSinceEpoch.load(std::memory_order_relaxed)
+            );
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == sequence) {
+                return Sample{counter, std::chrono::steady_clock::time_point(timeSinceEpoch)};
+            }
+        }
+    }
+
+    // block until a vblank with a counter past COUNTER gets published, or DEADLINE passes;
+    // false on timeout
+    bool WaitForVblankAfter(uint64_t counter, std::chrono::steady_clock::time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cvPublished.wait_until(lock, deadline, [this, counter]() {
+            std::optional<Sample> sample = Read();
+            return sample.has_value() && sample->counter > counter;
+        });
+    }
+
+  private:
+    std::atomic<uint64_t> _sequence = 0; // odd while a publish is in progress
+    std::atomic<uint64_t> _counter = 0;
+    std::atomic<std::chrono::steady_clock::rep> _timeSinceEpoch = 0; // in steady clock ticks
+    // only for waiters, readers never touch them
+    std::mutex _mutex;
+    std::condition_variable _cvPublished;
+};
@@ -0,0 +1,150 @@
+#include <algorithm>
+
+#include "VirtualDisplay.h"
+
+void VirtualDisplay::Init(const Config& config)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _config = config;
+    _rng.seed(std::random_device{}());
+    _lastVblank = {0, std::chrono::steady_clock::now()};
+    _upcomingVblanks.clear();
+    _nextNominalVblank = _lastVblank.time + std::chrono::nanoseconds(refreshPeriodNanoSeconds());
+    _lastShownVblank = 0;
+    _injectedStallNanoSeconds = 0;
+    _stats = {};
+}
+
+VirtualDisplay::Config VirtualDisplay::GetConfig() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _config;
+}
+
+void VirtualDisplay::SetConfig(const Config& config)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    advance(std::chrono::steady_clock::now());
+    _config = config;
+    // regenerate the vblanks ahead with the new period & jitter
+    _upcomingVblanks.clear();
+    _nextNominalVblank = _lastVblank.time + std::chrono::nanoseconds(refreshPeriodNanoSeconds());
+}
+
+void VirtualDisplay::InjectStall(int64_t nanoSeconds)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _injectedStallNanoSeconds += nanoSeconds;
+}
+
+uint64_t VirtualDisplay::GetVblankCounter()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    advance(std::chrono::steady_clock::now());
+    return _lastVblank.counter;
+}
+
+VirtualDisplay::Vblank VirtualDisplay::GetLastVblank()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    advance(std::chrono::steady_clock::now());
+    return _lastVblank;
+}
+
+std::chrono::steady_clock::time_point VirtualDisplay::GetNextVblankTime()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    advance(std::chrono::steady_clock::now());
+    return upcomingVblankTime(_lastVblank.counter + 1);
+}
+
+uint64_t VirtualDisplay::GetRefreshPeriodNanoSeconds() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return refreshPeriodNanoSeconds();
+}
+
+VirtualDisplay::PresentResult VirtualDisplay::Present(uint64_t sampledCounter)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto now = std::chrono::steady_clock::now();
+    advance(now);
+
+    int64_t readyNanoSeconds = _config.presentLatencyNanoSeconds;
+    if (_config.presentJitterNanoSeconds > 0) {
+        readyNanoSeconds += std::uniform_int_distribution<int64_t>(
+            0, _config.presentJitterNanoSeconds - 1
+        )(_rng);
+    }
+    bool stalled = _injectedStallNanoSeconds > 0;
+    readyNanoSeconds += _injectedStallNanoSeconds;
+    _injectedStallNanoSeconds = 0;
+    if (_config.stallProbability > 0
+        && std::bernoulli_distribution(std::min(_config.stallProbability, 1.0))(_rng)) {
+        stalled = true;
+        readyNanoSeconds += _config.stallNanoSeconds;
+    }
+    auto ready = now + std::chrono::nanoseconds(readyNanoSeconds);
+
+    // the first vblank past both the image being ready and the previous image's vblank
+    uint64_t vblank = std::max(_lastVblank.counter, _lastShownVblank) + 1;
+    while (upcomingVblankTime(vblank) < ready) {
+        vblank++;
+    }
+
+    _stats.numPresents++;
+    if (stalled) {
+        _stats.numStalls++;
+    }
+    if (_lastShownVblank != 0 && vblank > _lastShownVblank + 1) {
+        _stats.numRepeatedVblanks += vblank - _lastShownVblank - 1;
+    }
+    _lastShownVblank = vblank;
+    // meant for `sampledCounter + 1`; landing an even number of vblanks off keeps the parity
+    bool parityMiss = (vblank - sampledCounter) % 2 == 0;
+    if (parityMiss) {
+        _stats.numParityMisses++;
+    }
+    return {vblank, upcomingVblankTime(vblank), parityMiss};
+}
+
+VirtualDisplay::Stats VirtualDisplay::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void VirtualDisplay::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats = {};
+}
+
+void VirtualDisplay::advance(std::chrono::steady_clock::time_point now)
+{
+    while (upcomingVblankTime(_lastVblank.counter + 1) <= now) {
+        _lastVblank = {_lastVblank.counter + 1, _upcomingVblanks.front()};
+        _upcomingVblanks.pop_front();
+    }
+}
+
+std::chrono::steady_clock::time_point VirtualDisplay::upcomingVblankTime(uint64_t counter)
+{
+    int64_t period = refreshPeriodNanoSeconds();
+    // keeps vblanks in order
+    int64_t jitter = std::min(_config.vblankJitterNanoSeconds, period / 2 - 1);
+    while (_lastVblank.counter + _upcomingVblanks.size() < counter) {
+        int64_t offset = 0;
+        if (jitter > 0) {
+            offset = std::uniform_int_distribution<int64_t>(-jitter, jitter)(_rng);
+        }
+        _upcomingVblanks.push_back(_nextNominalVblank + std::chrono::nanoseconds(offset));
+        _nextNominalVblank += std::chrono::nanoseconds(period);
+    }
+    return _upcomingVblanks[counter - _lastVblank.counter - 1];
+}
+
+int64_t VirtualDisplay::refreshPeriodNanoSeconds() const
+{
+    return static_cast<int64_t>(1e9 / std::max(_config.refreshRateHz, 1.0));
+}
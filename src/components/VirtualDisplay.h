@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <random>
+
+// A display that only exists on paper: vblanks tick at a configurable refresh rate, and a
+// present gets shown at the first vblank after its image is ready, one image per vblank (FIFO).
+// Stands in for the display counter & present timing on machines without the lab rig, so that
+// even-odd parity can be exercised anywhere; see `Tetrium::TetraMode::kEvenOddVirtualSync`.
+// Vblanks are generated lazily off the steady clock. Thread-safe.
+class VirtualDisplay
+{
+  public:
+    struct Config
+    {
+        double refreshRateHz = 60.0;
+        // each vblank lands uniformly within +- this of its nominal time,
+        // clamped to under half a period
+        int64_t vblankJitterNanoSeconds = 0;
+        // from `Present()` until the image is ready for scan-out, i.e. the copy & compositor;
+        // each present adds a uniform [0, presentJitterNanoSeconds) on top
+        int64_t presentLatencyNanoSeconds = 1'000'000;
+        int64_t presentJitterNanoSeconds = 500'000;
+        // chance for a present to get held back by another `stallNanoSeconds`
+        double stallProbability = 0.0;
+        int64_t stallNanoSeconds = 20'000'000;
+    };
+
+    struct Vblank
+    {
+        uint64_t counter; // vblank counter after the vblank
+        std::chrono::steady_clock::time_point time;
+    };
+
+    struct PresentResult
+    {
+        uint64_t vblank; // counter of the vblank the image gets shown at
+        std::chrono::steady_clock::time_point time; // when it gets shown
+        // shown at a vblank whose parity differs from the one right after the sampled counter
+        bool parityMiss;
+    };
+
+    struct Stats
+    {
+        uint64_t numPresents = 0;
+        uint64_t numStalls = 0;
+        uint64_t numRepeatedVblanks = 0; // vblanks that showed the previous image again
+        uint64_t numParityMisses = 0;
+    };
+
+    // start counting vblanks from 0, now
+    void Init(const Config& config);
+
+    Config GetConfig() const;
+    void SetConfig(const Config& config); // takes effect from the next vblank not yet generated
+
+    // hold back the next present by NANOSECONDS, on top of the configured stalls
+    void InjectStall(int64_t nanoSeconds);
+
+    // number of vblanks so far, as the hardware surface counter would report it
+    uint64_t GetVblankCounter();
+    Vblank GetLastVblank();
+    std::chrono::steady_clock::time_point GetNextVblankTime();
+    uint64_t GetRefreshPeriodNanoSeconds() const;
+
+    // queue a present whose parity got sampled at SAMPLEDCOUNTER, meant for the vblank after it
+    PresentResult Present(uint64_t sampledCounter);
+
+    Stats GetStats() const;
+    void ResetStats();
+
+  private:
+    // move vblanks that happened by NOW out of `_upcomingVblanks`
+    void advance(std::chrono::steady_clock::time_point now);
+    // time of vblank COUNTER, past `_lastVblank`; generated on demand
+    std::chrono::steady_clock::time_point upcomingVblankTime(uint64_t counter);
+    int64_t refreshPeriodNanoSeconds() const;
+
+    mutable std::mutex _mutex;
+    Config _config;
+    std::mt19937_64 _rng;
+
+    Vblank _lastVblank{0, {}};
+    // times of vblanks `_lastVblank.counter + 1` onwards; future presents need them ahead of time
+    std::deque<std::chrono::steady_clock::time_point> _upcomingVblanks;
+    std::chrono::steady_clock::time_point _nextNominalVblank; // un-jittered, not generated yet
+    uint64_t _lastShownVblank = 0; // the vblank the latest present got shown at
+    int64_t _injectedStallNanoSeconds = 0;
+    Stats _stats;
+};
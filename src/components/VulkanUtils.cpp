@@ -110,6 +110,20 @@ uint32_t VulkanUtils::findMemoryType(
     FATAL("Failed to find suitable memory type!");
 }
 
+uint32_t VulkanUtils::findTransientAttachmentMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter) {
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
+
+    const VkMemoryPropertyFlags lazy = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & lazy) == lazy) {
+            return i;
+        }
+    }
+    // desktop GPUs don't have lazily allocated memory
+    return findMemoryType(physicalDevice, typeFilter, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
 void VulkanUtils::vkMemCopy(void* src, VkDeviceMemory dstMemory, VkDeviceSize size, VkDevice dstDevice) {
     void* data;
     vkMapMemory(dstDevice, dstMemory, 0, size, 0, &data);
@@ -197,7 +211,11 @@ void VulkanUtils::createImage(
     VkMemoryAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
     allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = VulkanUtils::findMemoryType(physicalDevice, memRequirements.memoryTypeBits, properties);
+    if (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
+        allocInfo.memoryTypeIndex = VulkanUtils::findTransientAttachmentMemoryType(physicalDevice, memRequirements.memoryTypeBits);
+    } else {
+        allocInfo.memoryTypeIndex = VulkanUtils::findMemoryType(physicalDevice, memRequirements.memoryTypeBits, properties);
+    }
 
     if (vkAllocateMemory(logicalDevice, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
         FATAL("Failed to allocate image memory!");
@@ -71,6 +71,11 @@ void createCommandPoolAndBuffers(
  */
 uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
+// memory type for images created with `VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT`, whose content
+// never outlives a render pass. Lazily allocated memory is preferred so that tilers can keep
+// the attachment on-chip without ever committing memory; device local otherwise.
+uint32_t findTransientAttachmentMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeFilter);
+
 void vkMemCopy(void* src, VkDeviceMemory dstMemory, VkDeviceSize size, VkDevice dstDevice);
 
 void copyBuffer(
@@ -98,6 +103,8 @@ VkFormat findBestFormat(
 
 VkFormat findDepthFormat(VkPhysicalDevice physicalDevice);
 
+// transient attachments, i.e. with `VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT` in USAGE,
+// get memory from `findTransientAttachmentMemoryType()` regardless of PROPERTIES
 void createImage(
     uint32_t width,
     uint32_t height,
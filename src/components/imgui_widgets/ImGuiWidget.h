@@ -1,7 +1,9 @@
 #pragma once
 #include "imgui.h"
+#include "components/Profiler.h"
 #include "structs/ColorSpace.h"
 #include <map>
+#include <optional>
 
 class Tetrium;
 
@@ -27,13 +29,24 @@ class ImGuiWidgetDeviceInfo : public ImGuiWidget
     virtual void Draw(const Tetrium* engine, ColorSpace colorSpace) override;
 };
 
-class ImGuiWidgetPerfPlot : public ImGuiWidget
+class ImGuiWidgetPerfPlot : public ImGuiWidgetMut
 {
 
   public:
-    virtual void Draw(const Tetrium* engine, ColorSpace colorSpace) override;
+    virtual void Draw(Tetrium* engine, ColorSpace colorSpace) override;
 
   private:
+    // scheduling of the thread that presents, and how often it got preempted
+    void drawPresentThread(Tetrium* engine, ColorSpace colorSpace);
+    // start & stop streaming the profiler entries to a trace file
+    void drawTraceRecording(Tetrium* engine, ColorSpace colorSpace);
+    // last tick's entries over time, a lane per thread and one for the GPU
+    void drawTimeline(Tetrium* engine);
+    // what profiling itself costs, measured on demand
+    void drawProfilerOverhead(Tetrium* engine, ColorSpace colorSpace);
+    // percentiles of every scope's time over a sliding window, against the refresh period
+    void drawScopeStats(Tetrium* engine, ColorSpace colorSpace);
+
     struct ScrollingBuffer
     {
         int MaxSize;
@@ -58,6 +71,9 @@ class ImGuiWidgetPerfPlot : public ImGuiWidget
     // lower-end systems the profiler plot itself consumes
     // CPU cycles (~2ms on a M3 mac)
     bool _wantShowPerfPlot = true;
+
+    std::optional<Profiler::BenchmarkResult> _profilerBenchmark;
+    uint32_t _scopeStatsWindow = 1; // into `ScopeStats::WINDOW_SLICES`
 };
 
 // view and edit engineUBO
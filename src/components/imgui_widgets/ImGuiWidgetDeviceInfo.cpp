@@ -27,7 +27,12 @@ void ImGuiWidgetDeviceInfo::Draw(const Tetrium* engine, ColorSpace colorSpace)
             ImGui::Text("Size: %i x %i", display.extent.width, display.extent.height);
             ImGui::Text("Refresh Rate: %i hz", static_cast<int>(display.refreshrate / 1000.0f));
         }
-        GLFWmonitor* monitor = glfwGetWindowMonitor(engine->_window);
+        if (engine->_tetraMode == Tetrium::TetraMode::kHeadless) {
+            ImGui::Text("Headless");
+            VkExtent2D extent = engine->_swapChain.extent;
+            ImGui::Text("Size: %i x %i", extent.width, extent.height);
+        }
+        GLFWmonitor* monitor = engine->_window ? glfwGetWindowMonitor(engine->_window) : nullptr;
         if (monitor) {
             ImGui::Text("Device: %s", glfwGetMonitorName(monitor));
             const GLFWvidmode* mode = glfwGetVideoMode(monitor);
@@ -35,7 +40,7 @@ void ImGuiWidgetDeviceInfo::Draw(const Tetrium* engine, ColorSpace colorSpace)
                 ImGui::Text("Size: %i x %i", mode->width, mode->height);
                 ImGui::Text("Refresh Rate: %i hz", mode->refreshRate);
             }
-        } else {
+        } else if (engine->_window) {
             ImGui::Text("Application running in windowed mode, no dedicated "
                         "display is used.");
         }
@@ -93,6 +93,20 @@ void ImGuiWidgetEvenOddCalibration::drawCalibrationWindow(Tetrium* engine, Color
     if (ImGui::Button("Reset") && colorSpace == ColorSpace::RGB) {
         engine->_evenOddDebugCtx.numDroppedFrames = 0;
     }
+#if __linux__
+    if (engine->_tetraMode == Tetrium::TetraMode::kEvenOddSoftwareSync) {
+        auto& ctx = engine->_presentWaitCtx;
+        ImGui::Text(
+            "Presents Completed: %llu, Repeated Vblanks: %llu",
+            (unsigned long long)ctx.numPresentsCompleted.load(),
+            (unsigned long long)ctx.numRepeatedVblanks.load()
+        );
+        ImGui::Text(
+            "Measured Refresh Period (ns): %llu",
+            (unsigned long long)ctx.refreshPeriodNanoSeconds.load()
+        );
+    }
+#endif // __linux__
 
     { // draw RGB OCV quads
         ImDrawList* dl = ImGui::GetWindowDrawList();
@@ -131,62 +145,6 @@ void ImGuiWidgetEvenOddCalibration::drawCalibrationWindow(Tetrium* engine, Color
     }
 
     ImGui::Checkbox("Flip RGB/OCV", &engine->_flipEvenOdd);
-    if (0 && engine->_tetraMode == Tetrium::TetraMode::kEvenOddSoftwareSync) {
-        ImGui::SliderInt(
-            "Software Sync Timing Offset (ns)",
-            &engine->_softwareEvenOddCtx.timeOffset,
-            0,
-            engine->_softwareEvenOddCtx.nanoSecondsPerFrame
-        );
-        ImGui::Text(
-            "Software Sync Frame Time (ns): %lu", engine->_softwareEvenOddCtx.nanoSecondsPerFrame
-        );
-        ImGui::SeparatorText("Auto Calibration");
-
-        if (!_calibrationInProgress) {
-            if (ImGui::Button("Calibrate") && colorSpace == ColorSpace::RGB) {
-                startAutoCalibration(engine);
-            }
-        } else {
-            if (ImGui::Button("Cancel")) {
-                _calibrationInProgress = false;
-            }
-            ImGui::SameLine();
-            ImGui::Text("Calibration in progress...");
-            ImGui::PushStyleColor(
-                ImGuiCol_PlotHistogram, ImVec4(0.3f, 0.7f, 0.3f, 1.0f)
-            ); // Green progress
-            ImGui::PushStyleColor(
-                ImGuiCol_FrameBg, ImVec4(0.1f, 0.1f, 0.1f, 1.0f)
-            ); // Dark background
-            ImGui::PushStyleVar(ImGuiStyleVar_FrameRounding, 5.0f);
-            ImGui::PushStyleVar(ImGuiStyleVar_FrameBorderSize, 1.0f);
-            ImGui::ProgressBar(_calibrationProgress, ImVec2{ImGui::GetWindowWidth() * 0.6f, 0});
-            ImGui::PopStyleVar(2);
-            ImGui::PopStyleColor(2);
-        }
-
-        // calibration results
-        if (_calibrationComplete) {
-            ImGui::PushStyleColor(
-                ImGuiCol_Text, ImVec4(0.0f, 1.0f, 0.0f, 1.0f)
-            ); // Bright green color
-            ImGui::Text("Calibration complete.");
-            ImGui::PopStyleColor();
-
-            ImGui::Text("Optimal offset: ");
-            ImGui::SameLine();
-            ImGui::TextColored(
-                ImVec4(0.0f, 1.0f, 0.5f, 1.0f), "%d ns", _optimalOffset.load()
-            ); // Light green color
-
-            ImGui::Text("Highest dropped frames at worst offset: ");
-            ImGui::SameLine();
-            ImGui::TextColored(
-                ImVec4(0.0f, 0.8f, 0.0f, 1.0f), "%d", _highestDroppedFrames.load()
-            ); // Slightly darker green
-        }
-    }
 
     ImGui::PopStyleColor();
     ImGui::End();
@@ -196,7 +154,8 @@ void ImGuiWidgetEvenOddCalibration::Draw(Tetrium* engine, ColorSpace colorSpace)
 {
     const char* evenOddMode = nullptr;
 
-    uint64_t numFrames = engine->getSurfaceCounterValue();
+    // as used by the latest frame, rather than querying the display again
+    const Tetrium::TimingSnapshot& timing = engine->_timingSnapshot;
     switch (engine->_tetraMode) {
     case Tetrium::TetraMode::kEvenOddSoftwareSync: {
         evenOddMode = "Software Sync";
@@ -204,20 +163,337 @@ void ImGuiWidgetEvenOddCalibration::Draw(Tetrium* engine, ColorSpace colorSpace)
     case Tetrium::TetraMode::kEvenOddHardwareSync:
         evenOddMode = "Hardware Sync";
         break;
+    case Tetrium::TetraMode::kEvenOddVirtualSync:
+        evenOddMode = "Virtual Display";
+        break;
     case Tetrium::TetraMode::kDualProjector:
         evenOddMode = "Dual Projector Does Not Use Even-Odd rendering";
         break;
+    case Tetrium::TetraMode::kHeadless:
+        evenOddMode = "Headless, Synthetic Vblank Every Tick";
+        break;
     }
     ImGui::Text("Even odd mode: %s", evenOddMode);
     bool isEven = engine->isEvenFrame();
 
-    ImGui::Text("Num Frame: %llu", numFrames);
+    ImGui::Text("Num Frame: %llu", (unsigned long long)timing.surfaceCounter);
+    ImGui::Text(
+        "Tick: %llu, Presented: %s, Refresh Period: %.3f ms",
+        (unsigned long long)timing.tick,
+        timing.colorSpace == RGB ? "RGB" : "OCV",
+        timing.refreshPeriodNanoSeconds / 1e6
+    );
+    if (timing.lastPresentTime.has_value()) {
+        ImGui::Text(
+            "Last Flip: %.3f ms before the parity sample",
+            std::chrono::duration<double, std::milli>(
+                timing.captureTime - timing.lastPresentTime.value()
+            )
+                .count()
+        );
+    }
 
     ImGui::Text("Num Dropped Frame: %u", engine->_evenOddDebugCtx.numDroppedFrames);
     ImGui::SameLine();
     if (ImGui::Button("Reset") && colorSpace == ColorSpace::RGB) {
         engine->_evenOddDebugCtx.numDroppedFrames = 0;
     }
+#if __linux__
+    if (engine->_tetraMode == Tetrium::TetraMode::kEvenOddSoftwareSync) {
+        auto& ctx = engine->_presentWaitCtx;
+        ImGui::Text(
+            "Presents Completed: %llu, Repeated Vblanks: %llu",
+            (unsigned long long)ctx.numPresentsCompleted.load(),
+            (unsigned long long)ctx.numRepeatedVblanks.load()
+        );
+        ImGui::Text(
+            "Measured Refresh Period (ns): %llu",
+            (unsigned long long)ctx.refreshPeriodNanoSeconds.load()
+        );
+    }
+#endif // __linux__
+
+    if (engine->_tetraMode == Tetrium::TetraMode::kEvenOddVirtualSync) {
+        ImGui::SeparatorText("Virtual Display");
+        VirtualDisplay& display = engine->_virtualDisplay;
+        VirtualDisplay::Config config = display.GetConfig();
+        bool changed = false;
+        float refreshRate = config.refreshRateHz;
+        if (ImGui::SliderFloat("Refresh Rate (Hz)", &refreshRate, 24.f, 240.f)) {
+            config.refreshRateHz = refreshRate;
+            changed = true;
+        }
+        int vblankJitterMicroSeconds = config.vblankJitterNanoSeconds / 1000;
+        if (ImGui::SliderInt("Vblank Jitter (us)", &vblankJitterMicroSeconds, 0, 2000)) {
+            config.vblankJitterNanoSeconds = vblankJitterMicroSeconds * 1000;
+            changed = true;
+        }
+        int presentLatencyMicroSeconds = config.presentLatencyNanoSeconds / 1000;
+        if (ImGui::SliderInt("Present Latency (us)", &presentLatencyMicroSeconds, 0, 20000)) {
+            config.presentLatencyNanoSeconds = presentLatencyMicroSeconds * 1000;
+            changed = true;
+        }
+        int presentJitterMicroSeconds = config.presentJitterNanoSeconds / 1000;
+        if (ImGui::SliderInt("Present Jitter (us)", &presentJitterMicroSeconds, 0, 10000)) {
+            config.presentJitterNanoSeconds = presentJitterMicroSeconds * 1000;
+            changed = true;
+        }
+        float stallProbability = config.stallProbability;
+        if (ImGui::SliderFloat("Stall Probability", &stallProbability, 0.f, 0.1f)) {
+            config.stallProbability = stallProbability;
+            changed = true;
+        }
+        int stallMilliSeconds = config.stallNanoSeconds / 1'000'000;
+        if (ImGui::SliderInt("Stall (ms)", &stallMilliSeconds, 1, 100)) {
+            config.stallNanoSeconds = stallMilliSeconds * 1'000'000ll;
+            changed = true;
+        }
+        if (changed && colorSpace == ColorSpace::RGB) {
+            display.SetConfig(config);
+        }
+        if (ImGui::Button("Inject Stall") && colorSpace == ColorSpace::RGB) {
+            display.InjectStall(config.stallNanoSeconds);
+        }
+        VirtualDisplay::Stats stats = display.GetStats();
+        ImGui::Text(
+            "Presents: %llu, Stalls: %llu",
+            (unsigned long long)stats.numPresents,
+            (unsigned long long)stats.numStalls
+        );
+        ImGui::Text(
+            "Repeated Vblanks: %llu, Parity Misses: %llu",
+            (unsigned long long)stats.numRepeatedVblanks,
+            (unsigned long long)stats.numParityMisses
+        );
+        ImGui::SameLine();
+        if (ImGui::Button("Reset##VirtualDisplay") && colorSpace == ColorSpace::RGB) {
+            display.ResetStats();
+        }
+    }
+
+    if (engine->_tetraMode == Tetrium::TetraMode::kEvenOddHardwareSync
+        || engine->_tetraMode == Tetrium::TetraMode::kEvenOddVirtualSync) {
+        ImGui::SeparatorText("Vblank Thread");
+        auto& ctx = engine->_vblankCtx;
+        ImGui::Text(
+            "Vblanks: %llu, Timeouts: %llu, %s",
+            (unsigned long long)ctx.numEvents.load(),
+            (unsigned long long)ctx.numTimeouts.load(),
+            ctx.realtime ? "Real-Time Priority" : "Normal Priority"
+        );
+        bool pacedSubmission = ctx.pacedSubmission;
+        if (ImGui::Checkbox("Submit Right After Imminent Vblanks", &pacedSubmission)
+            && colorSpace == ColorSpace::RGB) {
+            ctx.pacedSubmission = pacedSubmission;
+        }
+        int guardMicroSeconds = ctx.submitGuardNanoSeconds / 1000;
+        if (ImGui::SliderInt("Submit Guard (us)", &guardMicroSeconds, 0, 8000)
+            && colorSpace == ColorSpace::RGB) {
+            ctx.submitGuardNanoSeconds = guardMicroSeconds * 1000;
+        }
+        ImGui::Text("Waited Vblanks: %llu", (unsigned long long)ctx.numPacedWaits);
+    }
+
+    if (engine->_tetraMode == Tetrium::TetraMode::kEvenOddHardwareSync
+        || engine->_tetraMode == Tetrium::TetraMode::kEvenOddSoftwareSync
+        || engine->_tetraMode == Tetrium::TetraMode::kEvenOddVirtualSync) {
+        ImGui::SeparatorText("Auto Calibration");
+        auto& ctx = engine->_evenOddCalibrationCtx;
+        const EvenOddCalibrator& calibrator = ctx.calibrator;
+        if (!calibrator.IsRunning()) {
+            // the submit guard only acts once vblank times get published
+            bool canCalibrate = engine->_vblankCtx.clock.Read().has_value();
+            ImGui::BeginDisabled(!canCalibrate);
+            if (ImGui::Button("Calibrate Submit Guard") && colorSpace == ColorSpace::RGB) {
+                engine->startEvenOddCalibration();
+            }
+            ImGui::EndDisabled();
+            if (!canCalibrate) {
+                ImGui::SameLine();
+                ImGui::Text("No vblank times to calibrate against");
+            }
+        } else {
+            if (ImGui::Button("Cancel##Calibration") && colorSpace == ColorSpace::RGB) {
+                engine->cancelEvenOddCalibration();
+            }
+            ImGui::SameLine();
+            ImGui::ProgressBar(calibrator.GetProgress(), ImVec2{ImGui::GetWindowWidth() * 0.6f, 0});
+            ImGui::Text("Trying: %.3f ms", calibrator.GetOffset() / 1e6);
+        }
+        if (!calibrator.GetBins().empty()
+            && ImGui::BeginTable(
+                "Calibration", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
+            )) {
+            ImGui::TableSetupColumn("Guard (ms)");
+            ImGui::TableSetupColumn("Frames");
+            ImGui::TableSetupColumn("Drop Rate");
+            ImGui::TableSetupColumn("Interval");
+            ImGui::TableHeadersRow();
+            for (const EvenOddCalibrator::Bin& bin : calibrator.GetBins()) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%.3f", bin.offsetNanoSeconds / 1e6);
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%llu", (unsigned long long)bin.numFrames);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.2f%%", bin.dropRate * 100);
+                ImGui::TableSetColumnIndex(3);
+                if (bin.eliminated) {
+                    ImGui::TextDisabled("%.2f%% - %.2f%%", bin.lower * 100, bin.upper * 100);
+                } else {
+                    ImGui::Text("%.2f%% - %.2f%%", bin.lower * 100, bin.upper * 100);
+                }
+            }
+            ImGui::EndTable();
+        }
+        if (ctx.result.has_value()) {
+            const EvenOddCalibrator::Result& result = ctx.result.value();
+            ImGui::Text("Display Mode: %s", ctx.key.c_str());
+            ImGui::Text(
+                "Guard: %.3f ms, Drop Rate: %.2f%% (%.2f%% - %.2f%%)",
+                result.offsetNanoSeconds / 1e6,
+                result.dropRate * 100,
+                result.lower * 100,
+                result.upper * 100
+            );
+            ImGui::Text(
+                "Confidence: %.1f%%, over %llu frames",
+                result.confidence * 100,
+                (unsigned long long)result.numFrames
+            );
+        }
+    }
+
+    ImGui::SeparatorText("Dropped Frame Journal");
+    { // what ran long in the frames leading up to each drop
+        FrameJournal& journal = engine->_frameJournal;
+        ImGui::Text("Drops Journaled: %llu", (unsigned long long)journal.GetNumMisses());
+        ImGui::SameLine();
+        if (ImGui::Button("Clear##FrameJournal") && colorSpace == ColorSpace::RGB) {
+            journal.ClearSnapshots();
+        }
+        auto colorSpaceName = [](std::optional<ColorSpace> cs) {
+            return !cs.has_value() ? "-" : cs.value() == ColorSpace::RGB ? "RGB" : "OCV";
+        };
+        for (uint32_t i = 0; i < journal.GetNumSnapshots(); i++) {
+            const FrameJournal::Snapshot& snapshot = journal.GetSnapshot(i);
+            const FrameJournal::FrameRecord& miss = snapshot.frames[snapshot.numFrames - 1];
+            ImGui::PushID(i);
+            if (ImGui::TreeNode("Drop", "Drop at tick %llu", (unsigned long long)miss.tick)) {
+                ImGui::Text(
+                    "Counter: %llu, Expected: %s, Sampled: %s",
+                    (unsigned long long)miss.surfaceCounter,
+                    miss.expectedEven ? "Even" : "Odd",
+                    miss.sampledEven ? "Even" : "Odd"
+                );
+                ImGui::Text(
+                    "Predicted: %s, Presented: %s, Submit to Present: %.3f ms",
+                    colorSpaceName(miss.predictedColorSpace),
+                    colorSpaceName(miss.presentedColorSpace),
+                    std::chrono::duration<double, std::milli>(miss.presentTime - miss.submitTime)
+                        .count()
+                );
+                if (snapshot.numCulprits == 0) {
+                    ImGui::Text("No scope over budget in the last %u frames", snapshot.numFrames);
+                } else if (ImGui::BeginTable(
+                               "Culprits", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
+                           )) {
+                    ImGui::TableSetupColumn("Over Budget Scope");
+                    ImGui::TableSetupColumn("Frames");
+                    ImGui::TableSetupColumn("Worst (ms)");
+                    ImGui::TableSetupColumn("Usual (ms)");
+                    ImGui::TableHeadersRow();
+                    for (uint32_t j = 0; j < snapshot.numCulprits; j++) {
+                        const FrameJournal::Culprit& culprit = snapshot.culprits[j];
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        ImGui::Text("%s", culprit.name);
+                        ImGui::TableSetColumnIndex(1);
+                        ImGui::Text("%u / %u", culprit.numFrames, snapshot.numFrames);
+                        ImGui::TableSetColumnIndex(2);
+                        ImGui::Text("%.3f", culprit.worstNanoSeconds / 1e6);
+                        ImGui::TableSetColumnIndex(3);
+                        ImGui::Text("%.3f", culprit.usualNanoSeconds / 1e6);
+                    }
+                    ImGui::EndTable();
+                }
+                ImGui::TreePop();
+            }
+            ImGui::PopID();
+        }
+    }
+
+    ImGui::SeparatorText("Frame Pacing");
+    { // start ticks just in time for the next vblank
+        FramePacer::Config& config = engine->_framePacer.GetConfig();
+        const FramePacer::Stats& stats = engine->_framePacer.GetStats();
+        bool enabled = config.enabled;
+        if (ImGui::Checkbox("Enable##FramePacing", &enabled) && colorSpace == ColorSpace::RGB) {
+            config.enabled = enabled;
+        }
+        int safetyMarginMicroSeconds = config.safetyMarginNanoSeconds / 1000;
+        if (ImGui::SliderInt("Submit Margin (us)", &safetyMarginMicroSeconds, 0, 8000)
+            && colorSpace == ColorSpace::RGB) {
+            config.safetyMarginNanoSeconds = safetyMarginMicroSeconds * 1000;
+        }
+        int spinMicroSeconds = config.spinNanoSeconds / 1000;
+        if (ImGui::SliderInt("Spin (us)", &spinMicroSeconds, 0, 4000)
+            && colorSpace == ColorSpace::RGB) {
+            config.spinNanoSeconds = spinMicroSeconds * 1000;
+        }
+        ImGui::Text(
+            "%s, Period: %.3f ms, Phase Error: %.1f us",
+            stats.locked ? "Locked" : "Unlocked",
+            stats.periodNanoSeconds / 1e6,
+            stats.phaseErrorNanoSeconds / 1e3
+        );
+        ImGui::Text(
+            "Work: %.3f ms, Sleep: %.3f ms, Spin: %.1f us",
+            stats.workNanoSeconds / 1e6,
+            stats.sleepNanoSeconds / 1e6,
+            stats.spinNanoSeconds / 1e3
+        );
+        ImGui::Text(
+            "Paced: %llu, Late: %llu, Relocks: %llu",
+            (unsigned long long)stats.numPacedFrames,
+            (unsigned long long)stats.numLateFrames,
+            (unsigned long long)stats.numRelocks
+        );
+    }
+
+    ImGui::SeparatorText("Parity-Predictive Rendering");
+    { // render only the color space predicted to be presented
+        auto& ctx = engine->_parityPredictionCtx;
+        bool enabled = ctx.enabled;
+        if (ImGui::Checkbox("Enable", &enabled) && colorSpace == ColorSpace::RGB) {
+            ctx.enabled = enabled;
+        }
+        int safetyMarginMicroSeconds = ctx.safetyMarginNanoSeconds / 1000;
+        if (ImGui::SliderInt("Safety Margin (us)", &safetyMarginMicroSeconds, 0, 5000)
+            && colorSpace == ColorSpace::RGB) {
+            ctx.safetyMarginNanoSeconds = safetyMarginMicroSeconds * 1000;
+        }
+        float hitRate = ctx.numPredictions == 0
+                            ? 0.f
+                            : 100.f * static_cast<float>(ctx.numHits) / ctx.numPredictions;
+        ImGui::Text(
+            "Hit Rate: %.2f%% (%llu / %llu)",
+            hitRate,
+            (unsigned long long)ctx.numHits,
+            (unsigned long long)ctx.numPredictions
+        );
+        ImGui::Text("Dual-Rendered Frames: %llu", (unsigned long long)ctx.numDualRenders);
+        ImGui::Text(
+            "Prediction-to-Sample Latency: %.3f ms", ctx.predictionToSampleNanoSeconds / 1e6
+        );
+        ImGui::Text("Last Frame: %s", ctx.lastFramePredicted ? "Predicted" : "Dual");
+        ImGui::SameLine();
+        if (ImGui::Button("Reset Stats") && colorSpace == ColorSpace::RGB) {
+            ctx.numPredictions = 0;
+            ctx.numHits = 0;
+            ctx.numDualRenders = 0;
+        }
+    }
 
     ImGui::SeparatorText("Calibration");
     const char* colorSpaceStr = colorSpace == RGB ? "RGB" : "OCV";
@@ -297,155 +573,62 @@ void ImGuiWidgetEvenOddCalibration::Draw(Tetrium* engine, ColorSpace colorSpace)
     //     drawColorQuadTest();
     // }
 
-    // ImGui::Text("Stress Test");
-    //
-    // if (_stressTesting) {
-    //     ImGui::Text("Stress testing with %i threads...", NUM_STRESS_THREADS);
-    //     ImGui::SameLine();
-    //     if (ImGui::Button("Stop")) {
-    //         _stressTesting = false;
-    //     }
-    // } else {
-    //     if (ImGui::Button("Start")) {
-    //         for (int i = 0; i < NUM_STRESS_THREADS; i++) {
-    //             auto stressFunc = [this, i]() {
-    //                 while (_stressTesting) {
-    //                     std::cout << "here" << i << std::endl;
-    //                 }
-    //                 std::cout << i << "done" << std::endl;
-    //             };
-    //             _stressThreads[i] = std::thread(stressFunc);
-    //             _stressThreads[i].detach();
-    //         }
-    //         _stressTesting = true;
-    //     }
-    // }
-}
-
-int ImGuiWidgetEvenOddCalibration::measureDroppedFrames(Tetrium* engine, int offset, int duration)
-{
-    engine->_softwareEvenOddCtx.timeOffset = offset;
-    int initialDroppedFrames = engine->_evenOddDebugCtx.numDroppedFrames;
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(duration));
-
-    return engine->_evenOddDebugCtx.numDroppedFrames - initialDroppedFrames;
-}
-
-void ImGuiWidgetEvenOddCalibration::startAutoCalibration(Tetrium* engine)
-{
-    if (!_calibrationInProgress) {
-        _calibrationInProgress = true;
-        _calibrationProgress = 0.0f;
-        _calibrationComplete = false;
-        std::thread calibrationThread(
-            &ImGuiWidgetEvenOddCalibration::autoCalibrationThread, this, engine
-        );
-        calibrationThread.detach();
-    }
-}
-
-void ImGuiWidgetEvenOddCalibration::autoCalibrationThread(Tetrium* engine)
-{
-    int worstOffset = combinedCalibration(engine);
-    int optimalOffset = (engine->_softwareEvenOddCtx.nanoSecondsPerFrame / 2 + worstOffset)
-                        % engine->_softwareEvenOddCtx.nanoSecondsPerFrame;
-    _optimalOffset = optimalOffset;
-    if (_calibrationInProgress) {
-        engine->_softwareEvenOddCtx.timeOffset = _optimalOffset;
-        _calibrationComplete = true;
-    }
-    _calibrationInProgress = false;
-}
-
-int ImGuiWidgetEvenOddCalibration::combinedCalibration(Tetrium* engine)
-{
-    int maxOffset = engine->_softwareEvenOddCtx.nanoSecondsPerFrame;
-    int worstOffset = 0;
-    _highestDroppedFrames = std::numeric_limits<int>::min();
-
-    const float progBarPortionQuickScan = 0.8;
-    const float progBarPortionRecursiveDescent = 1 - progBarPortionQuickScan;
-
-    // Phase 1: Quick linear scan to find potential regions
-    const int quickScanStep = maxOffset / 300;
-    const int quickScanDuration = 20;
-    std::vector<int> highFreqOffsets; // offsets observing high-frequency dropped frames
-
-    for (int offset = 0; offset <= maxOffset; offset += quickScanStep) {
-        int droppedFrames = measureDroppedFrames(engine, offset, quickScanDuration);
-        if (droppedFrames > 0) {
-            highFreqOffsets.push_back(offset);
+    ImGui::SeparatorText("Load Generator");
+    { // synthetic load, to find how much the even-odd loop can take before frames drop
+        LoadGenerator& generator = engine->_loadGenerator;
+        LoadGenerator::Load load = generator.GetLoad();
+        int maxWorkers = generator.GetMaxWorkers();
+        bool changed = false;
+        int cpuThreads = load.cpuThreads;
+        changed |= ImGui::SliderInt("CPU Threads", &cpuThreads, 0, maxWorkers);
+        changed |= ImGui::SliderFloat("CPU Duty Cycle", &load.cpuDutyCycle, 0.f, 1.f);
+        int memoryThreads = load.memoryThreads;
+        changed |= ImGui::SliderInt("Memory Threads", &memoryThreads, 0, maxWorkers);
+        changed |= ImGui::SliderFloat("Memory Duty Cycle", &load.memoryDutyCycle, 0.f, 1.f);
+        int extraDrawInstances = load.extraDrawInstances;
+        changed |= ImGui::SliderInt("Extra Draw Instances", &extraDrawInstances, 0, 64);
+        if (changed && colorSpace == ColorSpace::RGB && !generator.IsSoaking()) {
+            load.cpuThreads = cpuThreads;
+            load.memoryThreads = memoryThreads;
+            load.extraDrawInstances = extraDrawInstances;
+            generator.SetLoad(load);
         }
-        _calibrationProgress = static_cast<float>(offset) / maxOffset * progBarPortionQuickScan;
-        if (!_calibrationInProgress)
-            return worstOffset;
-    }
-
-    const int recursiveDescentNumRegions = 50;
-    const int recursiveDescentStep = maxOffset / recursiveDescentNumRegions;
-    // cluster close offsets into regions
-    std::unordered_set<int> highFreqRegions;
-    for (int offset : highFreqOffsets) {
-        int region = std::round(offset / recursiveDescentStep);
-        highFreqRegions.insert(region);
-    }
-
-    // Phase 2: Recursive descent on potential regions
-    const int minStepSize = maxOffset / 1000; // 0.1% of frame time
-    float progressPerRegion = progBarPortionRecursiveDescent / highFreqRegions.size();
-
-    for (int region : highFreqRegions) {
-        int start = std::max(0, (int)std::round((region - 0.5) * recursiveDescentStep));
-        int end = std::min(maxOffset, (int)std::round((region + 0.5) * recursiveDescentStep));
-        recursiveDescentCalibration(
-            engine, start, end, minStepSize, worstOffset, progressPerRegion
-        );
-        if (!_calibrationInProgress)
-            break;
-    }
+        ImGui::Text("Memory Streamed: %.1f GB", generator.GetNumBytesStreamed() / 1e9);
 
-    return worstOffset;
-}
-
-void ImGuiWidgetEvenOddCalibration::recursiveDescentCalibration(
-    Tetrium* engine,
-    int start,
-    int end,
-    int stepSize,
-    int& worstOffset,
-    float progressWeight // how much of progress does this descent take?
-)
-{
-    const int recursiveDescentDuration = 100;
-    if (end - start <= stepSize || !_calibrationInProgress)
-        return;
-
-    int mid = start + (end - start) / 2;
-    int leftDropped = measureDroppedFrames(engine, start, recursiveDescentDuration);
-    int midDropped = measureDroppedFrames(engine, mid, recursiveDescentDuration);
-    int rightDropped = measureDroppedFrames(engine, end, recursiveDescentDuration);
-
-    if (leftDropped > _highestDroppedFrames) {
-        _highestDroppedFrames = leftDropped;
-        worstOffset = start;
-    }
-    if (midDropped > _highestDroppedFrames) {
-        _highestDroppedFrames = midDropped;
-        worstOffset = mid;
-    }
-    if (rightDropped > _highestDroppedFrames) {
-        _highestDroppedFrames = rightDropped;
-        worstOffset = end;
-    }
-
-    // this complete, update prog wait -- recurse
-    _calibrationProgress = _calibrationProgress + progressWeight / 3;
-
-    if (leftDropped > midDropped || rightDropped > midDropped) {
-        recursiveDescentCalibration(engine, start, mid, stepSize, worstOffset, progressWeight / 3);
-        recursiveDescentCalibration(engine, mid, end, stepSize, worstOffset, progressWeight / 3);
-    } else {
-        _calibrationProgress = _calibrationProgress + progressWeight * 2 / 3;
+        ImGui::SliderInt("Soak Seconds per Level", &_soakSecondsPerLevel, 5, 600);
+        if (!generator.IsSoaking()) {
+            if (ImGui::Button("Start Soak Test") && colorSpace == ColorSpace::RGB) {
+                generator.StartSoak(generator.GetDefaultSoakScript(_soakSecondsPerLevel));
+            }
+        } else {
+            if (ImGui::Button("Stop Soak Test") && colorSpace == ColorSpace::RGB) {
+                generator.StopSoak();
+            }
+            ImGui::SameLine();
+            ImGui::Text(
+                "Level %zu / %zu", generator.GetSoakLevel() + 1, generator.GetNumSoakLevels()
+            );
+        }
+        const std::vector<LoadGenerator::SoakResult>& results = generator.GetSoakResults();
+        if (!results.empty()
+            && ImGui::BeginTable("Soak", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Load Level");
+            ImGui::TableSetupColumn("Frames");
+            ImGui::TableSetupColumn("Dropped");
+            ImGui::TableSetupColumn("Drops / min");
+            ImGui::TableHeadersRow();
+            for (const LoadGenerator::SoakResult& result : results) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%s", result.name);
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%llu", (unsigned long long)result.numFrames);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%llu", (unsigned long long)result.numDroppedFrames);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.2f", result.GetDropsPerMinute());
+            }
+            ImGui::EndTable();
+        }
     }
 }
@@ -19,4 +19,102 @@ void ImGuiWidgetGraphicsPipeline::Draw(Tetrium* engine, ColorSpace colorSpace)
         );
         ImGui::Indent(-10);
     }
+
+    ImGui::SeparatorText("Static-Frame Cache");
+    {
+        auto& ctx = engine->_staticFrameCtx;
+        bool enabled = ctx.enabled;
+        if (ImGui::Checkbox("Enable", &enabled) && colorSpace == ColorSpace::RGB) {
+            ctx.enabled = enabled;
+        }
+        ImGui::Text("Cached Frames: %llu", (unsigned long long)ctx.numCachedFrames);
+        ImGui::TextWrapped("Frames are served from cache only when no tab with live content "
+                           "(e.g. this one) is shown.");
+    }
+
+    ImGui::SeparatorText("Multiview");
+    {
+        auto& ctx = engine->_multiviewCtx;
+        bool enabled = ctx.enabled;
+        ImGui::BeginDisabled(!ctx.supported);
+        if (ImGui::Checkbox("Render Color Spaces in a Single Pass", &enabled)
+            && colorSpace == ColorSpace::RGB) {
+            ctx.enabled = enabled;
+        }
+        ImGui::EndDisabled();
+        if (!ctx.requested) {
+            ImGui::Text("Off, relaunch with `--multiview` to use");
+        } else if (!ctx.supported) {
+            ImGui::Text("Unsupported by the device or missing shaders");
+        }
+    }
+
+    ImGui::SeparatorText("Command Recording");
+    {
+        auto& ctx = engine->_parallelRecordingCtx;
+        bool enabled = ctx.enabled;
+        if (ImGui::Checkbox("Record Color Spaces in Parallel", &enabled)
+            && colorSpace == ColorSpace::RGB) {
+            ctx.enabled = enabled;
+        }
+        ImGui::Text("Recording Threads: %zu", engine->_threadPool.GetNumThreads());
+        if (engine->_renderThreadCtx.enabled) {
+            ImGui::Text(
+                "Dedicated Render Thread, Dropped Window Events: %llu",
+                (unsigned long long)engine->_renderThreadCtx.numDroppedWindowEvents.load()
+            );
+        } else {
+            ImGui::Text("Rendering on the Window Thread");
+        }
+        if (engine->_multiviewCtx.enabled) {
+            ImGui::Text("Unused under multiview, the scene is recorded once");
+        }
+    }
+
+    ImGui::SeparatorText("Frame Graph");
+    {
+        const FrameGraph& graph = engine->_frameGraph;
+        const FrameGraph::Stats& stats = graph.GetStats(); // of the last rendered frame
+        ImGui::Text(
+            "Barriers: %s", graph.IsSynchronization2() ? "synchronization2" : "legacy"
+        );
+        ImGui::Text("Passes: %u, Culled: %u", stats.numPasses, stats.numCulledPasses);
+        ImGui::Text(
+            "Pipeline Barriers: %u, Image Barriers: %u",
+            stats.numBarriers,
+            stats.numImageBarriers
+        );
+    }
+
+    ImGui::SeparatorText("ImGui Pass");
+    {
+        // fixed at init, relaunch with `--separate-imgui-pass` to compare in the perf plot
+        ImGui::Text(
+            "%s",
+            engine->_imguiCtx.mergedIntoMainPass ? "Subpass of the main render pass"
+                                                  : "Separate render pass"
+        );
+        if (engine->_multiviewCtx.supported) {
+            ImGui::Text("Kept separate, the multiview pass can't host imgui");
+        }
+        if (!engine->_gpuProfiler.IsSupported()) {
+            ImGui::Text("GPU timestamps unsupported, GPU profiler entries are unavailable");
+        }
+    }
+
+    ImGui::SeparatorText("Clock Domains");
+    {
+        const ClockDomains& clocks = engine->_clockDomains;
+        if (clocks.IsDeviceCalibrated()) {
+            ImGui::Text(
+                "GPU Clock Calibrated, Max Deviation: %llu ns",
+                (unsigned long long)clocks.GetCalibration()->maxDeviationNanoSeconds
+            );
+        } else {
+            ImGui::Text("GPU Clock Uncalibrated, GPU profiler entries keep their durations only");
+        }
+        ImGui::Text(
+            "Present Clock Offset: %lld ns", (long long)clocks.GetPresentOffsetNanoSeconds()
+        );
+    }
 }
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <ctime>
+#include <string_view>
+
 #include "implot.h"
 
 #include "ImGuiWidget.h"
@@ -29,12 +33,273 @@ void ImGuiWidgetPerfPlot::ScrollingBuffer::Erase()
     }
 }
 
-void ImGuiWidgetPerfPlot::Draw(const Tetrium* engine, ColorSpace colorSpace)
+static double getEntryMilliseconds(const Profiler::Entry& entry)
+{
+    return std::chrono::duration<double, std::chrono::milliseconds::period>(
+               entry.end - entry.begin
+    )
+        .count();
+}
+
+void ImGuiWidgetPerfPlot::drawPresentThread(Tetrium* engine, ColorSpace colorSpace)
+{
+#if __linux__
+    auto& ctx = engine->_presentThreadCtx;
+    bool requested = ctx.requested;
+    if (ImGui::Checkbox("Pin & Real-Time Schedule", &requested) && colorSpace == ColorSpace::RGB) {
+        ctx.requested = requested; // applied by the present thread on its next tick
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6);
+    int requestedCore = ctx.requestedCore;
+    if (ImGui::InputInt("Core (-1: auto)", &requestedCore) && colorSpace == ColorSpace::RGB) {
+        ctx.requestedCore = std::max(requestedCore, -1);
+        ctx.applied = !ctx.requested; // re-apply with the new core
+    }
+    ImGui::Text(
+        "Core: %s, Scheduling: %s",
+        ctx.core < 0 ? "any" : std::to_string(ctx.core).c_str(),
+        ctx.realtime ? "SCHED_FIFO" : ctx.niced ? "nice -20" : "normal"
+    );
+    if (!ctx.lastSwitches.has_value()) {
+        ImGui::Text("Context switches unavailable, /proc/thread-self/status unreadable");
+        return;
+    }
+    ImGui::Text(
+        "Involuntary Switches: %u last frame, %.2f per frame",
+        ctx.lastFrameInvoluntarySwitches,
+        ctx.involuntarySwitchesPerFrame
+    );
+    ImGui::Text(
+        "Frames Switched Out: %llu / %llu, %llu switches",
+        (unsigned long long)ctx.numFramesSwitchedOut,
+        (unsigned long long)ctx.numFrames,
+        (unsigned long long)ctx.numInvoluntarySwitches
+    );
+    ImGui::SameLine();
+    if (ImGui::Button("Reset##PresentThread") && colorSpace == ColorSpace::RGB) {
+        ctx.numFramesSwitchedOut = 0;
+        ctx.numFrames = 0;
+        ctx.numInvoluntarySwitches = 0;
+        ctx.history.fill(0);
+    }
+    ImGui::PlotHistogram(
+        "##InvoluntarySwitches",
+        ctx.history.data(),
+        ctx.history.size(),
+        ctx.numFrames % ctx.history.size(), // oldest first
+        "Involuntary switches per frame",
+        0.f,
+        FLT_MAX,
+        ImVec2{ImGui::GetWindowWidth() * 0.9f, 60}
+    );
+#else
+    ImGui::Text("Not supported on this platform");
+#endif // __linux__
+}
+
+void ImGuiWidgetPerfPlot::drawTraceRecording(Tetrium* engine, ColorSpace colorSpace)
+{
+    TraceRecorder& recorder = engine->_traceRecorder;
+    if (!recorder.IsRecording()) {
+        if (ImGui::Button("Start Recording") && colorSpace == ColorSpace::RGB) {
+            // a new file each time, in the working directory
+            char path[64];
+            std::time_t now = std::time(nullptr);
+            std::strftime(path, sizeof(path), "trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+            if (!recorder.Start(path)) {
+                WARN("Failed to open trace file {}", path);
+            }
+        }
+        if (!recorder.GetPath().empty()) {
+            ImGui::SameLine();
+            ImGui::Text("Last: %s", recorder.GetPath().c_str());
+        }
+        return;
+    }
+    if (ImGui::Button("Stop Recording") && colorSpace == ColorSpace::RGB) {
+        recorder.Stop();
+        return;
+    }
+    ImGui::SameLine();
+    ImGui::Text("%s", recorder.GetPath().c_str());
+    ImGui::Text(
+        "Events Written: %llu, Dropped: %llu",
+        (unsigned long long)recorder.GetNumEventsWritten(),
+        (unsigned long long)recorder.GetNumEventsDropped()
+    );
+    ImGui::TextWrapped("Open in chrome://tracing or ui.perfetto.dev once stopped.");
+}
+
+void ImGuiWidgetPerfPlot::drawProfilerOverhead(Tetrium* engine, ColorSpace colorSpace)
+{
+    const Profiler& profiler = engine->_profiler;
+    ImGui::Text(
+        "Clock: %s, Dropped Entries: %llu",
+        profiler.IsClockTSC() ? "Invariant TSC" : "Steady Clock",
+        (unsigned long long)profiler.GetNumDroppedEntries()
+    );
+    // stalls the tick for a few milliseconds
+    if (ImGui::Button("Measure Scope Cost") && colorSpace == ColorSpace::RGB) {
+        _profilerBenchmark = Profiler::Benchmark(1 << 18);
+    }
+    if (_profilerBenchmark.has_value()) {
+        ImGui::Text(
+            "Scope: %.1f ns, Clock Read: %.1f ns, Merge: %.1f ns per entry",
+            _profilerBenchmark->scopeNanoSeconds,
+            _profilerBenchmark->clockNanoSeconds,
+            _profilerBenchmark->mergeNanoSeconds
+        );
+    }
+}
+
+void ImGuiWidgetPerfPlot::drawScopeStats(Tetrium* engine, ColorSpace colorSpace)
+{
+    const ScopeStats& stats = engine->_scopeStats;
+    double budgetMilliseconds = engine->_timingSnapshot.refreshPeriodNanoSeconds / 1e6;
+    for (uint32_t w = 0; w < ScopeStats::NUM_WINDOWS; w++) {
+        std::string label = "Last " + std::to_string(ScopeStats::WINDOW_SLICES[w]) + "s";
+        if (ImGui::RadioButton(label.c_str(), _scopeStatsWindow == w)
+            && colorSpace == ColorSpace::RGB) {
+            _scopeStatsWindow = w;
+        }
+        ImGui::SameLine();
+    }
+    if (budgetMilliseconds > 0) {
+        ImGui::Text("Budget: %.3f MS (refresh period)", budgetMilliseconds);
+    } else {
+        ImGui::Text("Budget: unknown refresh period");
+    }
+    if (stats.GetNumUntrackedEntries() != 0) {
+        ImGui::Text(
+            "Untracked Entries: %llu (more than %u scopes)",
+            (unsigned long long)stats.GetNumUntrackedEntries(),
+            ScopeStats::MAX_SCOPES
+        );
+    }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
+    if (!ImGui::BeginTable("Scope Statistics", 7, flags)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Scope");
+    for (const char* column : {"Runs", "P50 MS", "P95 MS", "P99 MS", "Max MS", "Over Budget"}) {
+        ImGui::TableSetupColumn(column);
+    }
+    ImGui::TableHeadersRow();
+    for (const ScopeStats::Summary& summary : stats.GetSummaries()) {
+        const ScopeStats::WindowStats& window = summary.windows[_scopeStatsWindow];
+        if (window.count == 0) {
+            continue;
+        }
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", summary.name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", (unsigned long long)window.count);
+        // the tail past the budget is what costs vblanks
+        for (int64_t nanoSeconds :
+             {window.p50NanoSeconds,
+              window.p95NanoSeconds,
+              window.p99NanoSeconds,
+              window.maxNanoSeconds}) {
+            ImGui::TableNextColumn();
+            double milliseconds = nanoSeconds / 1e6;
+            if (budgetMilliseconds > 0 && milliseconds > budgetMilliseconds) {
+                ImGui::TextColored(ImVec4(1, 0.3f, 0.3f, 1), "%.3f", milliseconds);
+            } else {
+                ImGui::Text("%.3f", milliseconds);
+            }
+        }
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", (unsigned long long)window.numOverBudget);
+    }
+    ImGui::EndTable();
+}
+
+void ImGuiWidgetPerfPlot::drawTimeline(Tetrium* engine)
+{
+    const std::vector<Profiler::Entry>& profile = *engine->_lastProfilerData;
+    if (profile.empty()) {
+        return;
+    }
+    struct Lane
+    {
+        const char* name;
+        uint32_t threadId;
+        bool gpu;
+        int numLevels = 0;
+    };
+    std::vector<Lane> lanes; // threads in the order they got profiled, then the GPU
+    Profiler::TimeUnit begin = profile.front().begin;
+    Profiler::TimeUnit end = profile.front().end;
+    for (const Profiler::Entry& entry : profile) {
+        auto lane = std::find_if(lanes.begin(), lanes.end(), [&entry](const Lane& lane) {
+            return lane.gpu == entry.gpu && (entry.gpu || lane.threadId == entry.threadId);
+        });
+        if (lane == lanes.end()) {
+            lanes.push_back({entry.gpu ? "GPU" : entry.threadName, entry.threadId, entry.gpu});
+            lane = lanes.end() - 1;
+        }
+        lane->numLevels = std::max(lane->numLevels, entry.level + 1);
+        begin = std::min(begin, entry.begin);
+        end = std::max(end, entry.end);
+    }
+    std::stable_partition(lanes.begin(), lanes.end(), [](const Lane& lane) { return !lane.gpu; });
+
+    // GPU entries of a frame in flight ago overlap this tick's CPU entries
+    double spanNanoSeconds = std::max<double>((end - begin).count(), 1);
+    ImGui::Text("%.3f ms across %zu lanes", spanNanoSeconds / 1e6, lanes.size());
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    float width = ImGui::GetContentRegionAvail().x;
+    float rowHeight = ImGui::GetTextLineHeight() + 2;
+    for (const Lane& lane : lanes) {
+        ImGui::TextDisabled("%s", lane.name);
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        for (const Profiler::Entry& entry : profile) {
+            if (entry.gpu != lane.gpu || (!lane.gpu && entry.threadId != lane.threadId)) {
+                continue;
+            }
+            float x0 = origin.x + width * (entry.begin - begin).count() / spanNanoSeconds;
+            float x1 = origin.x + width * (entry.end - begin).count() / spanNanoSeconds;
+            x1 = std::max(x1, x0 + 1); // keep the shortest scopes visible
+            float y0 = origin.y + entry.level * rowHeight;
+            ImVec2 min{x0, y0};
+            ImVec2 max{x1, y0 + rowHeight - 1};
+            // a stable color per scope name
+            float hue = std::hash<std::string_view>{}(entry.name) % 360 / 360.f;
+            drawList->AddRectFilled(min, max, ImColor::HSV(hue, 0.5f, 0.6f));
+            drawList->PushClipRect(min, max, true);
+            drawList->AddText(ImVec2{x0 + 2, y0}, IM_COL32_WHITE, entry.name);
+            drawList->PopClipRect();
+            if (ImGui::IsMouseHoveringRect(min, max)) {
+                ImGui::SetTooltip(
+                    "%s: %f MS\n%s:%u",
+                    entry.name,
+                    getEntryMilliseconds(entry),
+                    entry.scope ? entry.scope->file : "recorded",
+                    entry.scope ? entry.scope->line : 0
+                );
+            }
+        }
+        ImGui::Dummy(ImVec2{width, lane.numLevels * rowHeight});
+    }
+}
+
+void ImGuiWidgetPerfPlot::Draw(Tetrium* engine, ColorSpace colorSpace)
 {
     ImGui::Checkbox("Show Perf Plot", std::addressof(_wantShowPerfPlot));
     double deltaTimeSeconds = engine->_deltaTimer.GetDeltaTimeSeconds();
     ImGui::Text("Framerate: %f", 1 / deltaTimeSeconds);
 
+    ImGui::SeparatorText("Present Thread");
+    drawPresentThread(engine, colorSpace);
+    ImGui::SeparatorText("Trace Recording");
+    drawTraceRecording(engine, colorSpace);
+    ImGui::SeparatorText("Profiler Overhead");
+    drawProfilerOverhead(engine, colorSpace);
+    ImGui::Separator();
+
     bool showingPlot = false;
     if (_wantShowPerfPlot) {
         ImVec2 plotSize = {ImGui::GetWindowWidth(), ImGui::GetWindowHeight() / 2};
@@ -61,13 +326,7 @@ void ImGuiWidgetPerfPlot::Draw(const Tetrium* engine, ColorSpace colorSpace)
     ASSERT(engine->_lastProfilerData != nullptr);
 
     // iterate over entries, update scrolling buffers and plot
-    // also shows text for the raw numbers under the plot
-    for (Profiler::Entry& entry : *engine->_lastProfilerData) {
-        // ms time
-        double ms = std::chrono::duration<double, std::chrono::milliseconds::period>(
-                        entry.end - entry.begin
-        )
-                        .count();
+    for (const Profiler::Entry& entry : *engine->_lastProfilerData) {
         if (showingPlot) {
             auto it = _scrollingBuffers.find(entry.name);
             if (it == _scrollingBuffers.end()) {
@@ -80,7 +339,7 @@ void ImGuiWidgetPerfPlot::Draw(const Tetrium* engine, ColorSpace colorSpace)
             // NOTE: we only update the scrolling buffer on RGB pass,
             // and present on OCV pass; no need to write the same data twice.
             if (colorSpace == ColorSpace::RGB) {
-                buf.AddPoint(engine->_timeSinceStartSeconds, ms);
+                buf.AddPoint(engine->_timeSinceStartSeconds, getEntryMilliseconds(entry));
             }
             if (!buf.Empty()) {
                 ImPlot::PlotLine(
@@ -94,20 +353,45 @@ void ImGuiWidgetPerfPlot::Draw(const Tetrium* engine, ColorSpace colorSpace)
                 );
             }
         }
-        { // text section
-            int indentWidth = entry.level * 10;
-            if (indentWidth != 0) {
-                ImGui::Indent(indentWidth);
-            }
-            // entry name
-            ImGui::Text("%s", entry.name);
-            ImGui::Text("%f MS", ms);
-            if (indentWidth != 0) {
-                ImGui::Unindent(indentWidth);
-            }
-        }
     }
     if (showingPlot) {
         ImPlot::EndPlot();
     }
+
+    ImGui::SeparatorText("Timeline");
+    drawTimeline(engine);
+    ImGui::SeparatorText("Scope Statistics");
+    drawScopeStats(engine, colorSpace);
+
+    // text section for the raw numbers under the plot, GPU scopes next to the CPU ones
+    if (ImGui::BeginTable("Profiler Entries", 2, ImGuiTableFlags_BordersInnerV)) {
+        ImGui::TableSetupColumn("CPU");
+        ImGui::TableSetupColumn("GPU");
+        ImGui::TableHeadersRow();
+        ImGui::TableNextRow();
+        for (bool gpu : {false, true}) {
+            ImGui::TableSetColumnIndex(gpu);
+            const char* threadName = nullptr;
+            for (const Profiler::Entry& entry : *engine->_lastProfilerData) {
+                if (entry.gpu != gpu) {
+                    continue;
+                }
+                if (!gpu && entry.threadName != threadName) { // entries come grouped by thread
+                    threadName = entry.threadName;
+                    ImGui::SeparatorText(threadName);
+                }
+                int indentWidth = entry.level * 10;
+                if (indentWidth != 0) {
+                    ImGui::Indent(indentWidth);
+                }
+                // entry name
+                ImGui::Text("%s", entry.name);
+                ImGui::Text("%f MS", getEntryMilliseconds(entry));
+                if (indentWidth != 0) {
+                    ImGui::Unindent(indentWidth);
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
 };
@@ -23,6 +23,9 @@ void SimpleRenderSystem::Init(const InitContext* ctx)
     _renderSystemContexts[RGB]._vertShader = ctx->VERTEX_SHADER_SRC;
     _renderSystemContexts[OCV]._vertShader = ctx->VERTEX_SHADER_SRC;
 
+    _multiviewRenderSystemContext._fragShader = ctx->FRAGMENT_SHADER_MULTIVIEW_SRC;
+    _multiviewRenderSystemContext._vertShader = ctx->VERTEX_SHADER_SRC;
+
     createGraphicsPipeline(ctx->renderPasses[RGB], ctx->renderPasses[OCV], ctx);
 }
 
@@ -37,7 +40,7 @@ void SimpleRenderSystem::Cleanup()
         mesh.second.vertexBuffer.Cleanup();
     }
 
-    for (auto& ctx : {&(_renderSystemContexts[RGB]), &(_renderSystemContexts[OCV])}) {
+    for (RenderSystemContext* ctx : getBuiltContexts()) {
         // clean up static UBO & dynamic UBO
         for (int i = 0; i < ctx->_UBO.size(); i++) {
             ctx->_UBO[i].dynamicUBO.Cleanup();
@@ -107,7 +110,14 @@ void SimpleRenderSystem::render(const TickContext* tickCtx, RenderSystemContext&
         }
 
         { // issue draw call
-            vkCmdDrawIndexed(CB, meshInstance->mesh->indexBuffer.numIndices, 1, 0, 0, 0);
+            vkCmdDrawIndexed(
+                CB,
+                meshInstance->mesh->indexBuffer.numIndices,
+                1 + tickCtx->extraDrawInstances, // overlapping, only ever the first one shows
+                0,
+                0,
+                0
+            );
         }
     }
 }
@@ -117,6 +127,41 @@ void SimpleRenderSystem::Tick(const TickContext* ctx, ColorSpace cs)
     render(ctx, _renderSystemContexts[cs]);
 }
 
+void SimpleRenderSystem::TickMultiview(const TickContext* ctx)
+{
+    ASSERT(_multiviewRenderSystemContext._pipeline != VK_NULL_HANDLE);
+    render(ctx, _multiviewRenderSystemContext);
+}
+
+std::vector<SimpleRenderSystem::RenderSystemContext*> SimpleRenderSystem::getBuiltContexts()
+{
+    std::vector<RenderSystemContext*> contexts
+        = {&_renderSystemContexts[RGB], &_renderSystemContexts[OCV]};
+    if (_multiviewRenderSystemContext._pipeline != VK_NULL_HANDLE) {
+        contexts.push_back(&_multiviewRenderSystemContext);
+    }
+    return contexts;
+}
+
+bool SimpleRenderSystem::PollTransformChanges()
+{
+    bool changed = _lastTransforms.size() != _entities.size() * 3;
+    _lastTransforms.resize(_entities.size() * 3);
+    for (size_t i = 0; i < _entities.size(); i++) {
+        TransformComponent* transform = _entities[i]->GetComponent<TransformComponent>();
+        ASSERT(transform != nullptr)
+        glm::vec3* last = &_lastTransforms[i * 3];
+        if (last[0] != transform->position || last[1] != transform->rotation
+            || last[2] != transform->scale) {
+            last[0] = transform->position;
+            last[1] = transform->rotation;
+            last[2] = transform->scale;
+            changed = true;
+        }
+    }
+    return changed;
+}
+
 void SimpleRenderSystem::buildPipelineForContext(
     const VkRenderPass pass,
     const InitContext* initData,
@@ -448,7 +493,7 @@ void SimpleRenderSystem::createGraphicsPipeline(
         poolInfo.poolSizeCount
             = sizeof(poolSizes) / sizeof(VkDescriptorPoolSize); // number of pool sizes
         poolInfo.pPoolSizes = poolSizes;
-        poolInfo.maxSets = NUM_FRAME_IN_FLIGHT * poolInfo.poolSizeCount;
+        poolInfo.maxSets = NUM_FRAME_IN_FLIGHT * 3; // RGB, OCV and multiview contexts
         poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
 
         if (vkCreateDescriptorPool(_device->logicalDevice, &poolInfo, nullptr, &_descriptorPool)
@@ -459,6 +504,11 @@ void SimpleRenderSystem::createGraphicsPipeline(
 
     buildPipelineForContext(renderPassRGB, initData, _renderSystemContexts[RGB]);
     buildPipelineForContext(renderPassOCV, initData, _renderSystemContexts[OCV]);
+    if (initData->multiviewRenderPass != VK_NULL_HANDLE) {
+        buildPipelineForContext(
+            initData->multiviewRenderPass, initData, _multiviewRenderSystemContext
+        );
+    }
 }
 
 MeshComponent* SimpleRenderSystem::MakeMeshInstanceComponent(
@@ -515,8 +565,9 @@ MeshComponent* SimpleRenderSystem::MakeMeshInstanceComponent(
             _currDynamicUBO++;
             if (_currDynamicUBO >= _numDynamicUBO) {
                 _numDynamicUBO *= 1.5;
-                resizeDynamicUbo(_renderSystemContexts[RGB], _numDynamicUBO); // grow dynamic UBO
-                resizeDynamicUbo(_renderSystemContexts[OCV], _numDynamicUBO); // grow dynamic UBO
+                for (RenderSystemContext* ctx : getBuiltContexts()) {
+                    resizeDynamicUbo(*ctx, _numDynamicUBO); // grow dynamic UBO
+                }
             }
         }
     }
@@ -574,12 +625,11 @@ void SimpleRenderSystem::resizeDynamicUbo(RenderSystemContext& ctx, size_t dynam
 void SimpleRenderSystem::updateTextureDescriptorSet()
 {
     DEBUG("updating texture descirptor set");
-    for (const RenderSystemContext& ctx :
-         {_renderSystemContexts[RGB], _renderSystemContexts[OCV]}) {
+    for (const RenderSystemContext* ctx : getBuiltContexts()) {
         for (size_t i = 0; i < NUM_FRAME_IN_FLIGHT; i++) {
             std::array<VkWriteDescriptorSet, 1> descriptorWrites{};
             descriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            descriptorWrites[0].dstSet = ctx._descriptorSets[i];
+            descriptorWrites[0].dstSet = ctx->_descriptorSets[i];
             descriptorWrites[0].dstBinding = (int)BindingLocation::TEXTURE_SAMPLER;
             descriptorWrites[0].dstArrayElement = 0;
             descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
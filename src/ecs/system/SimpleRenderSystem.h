@@ -53,6 +53,12 @@ class SimpleRenderSystem : public ISystem
 
     void Tick(const TickContext* ctx, ColorSpace cs);
 
+    // render all color spaces at once, inside `InitContext::multiviewRenderPass`
+    void TickMultiview(const TickContext* ctx);
+
+    // whether any entity's transform has changed since the last poll
+    bool PollTransformChanges();
+
     void Cleanup() override;
 
   private:
@@ -73,6 +79,14 @@ class SimpleRenderSystem : public ISystem
     };
 
     RenderSystemContext _renderSystemContexts[ColorSpace::ColorSpaceSize];
+    // context for the multiview pass, its pipeline stays VK_NULL_HANDLE if multiview is unused
+    RenderSystemContext _multiviewRenderSystemContext;
+
+    // all contexts whose pipelines have been built
+    std::vector<RenderSystemContext*> getBuiltContexts();
+
+    // [position, rotation, scale] of each entity as of the last `PollTransformChanges()`
+    std::vector<glm::vec3> _lastTransforms;
 
 
     void render(const TickContext* tickCtx, RenderSystemContext& renderCtx);
@@ -1,38 +1,36 @@
 #include "Utils.h"
 
-void Utils::ImageTransfer::CmdCopyToFB(
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#if __linux__ || __APPLE__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if __linux__
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+void Utils::ImageTransfer::CmdCopyImage(
     VkCommandBuffer commandBuffer,
-    VkImage& src,
-    VkImage& dst,
-    VkExtent2D extent
+    VkImage src,
+    VkImage dst,
+    VkExtent2D extent,
+    uint32_t srcLayer
 )
 {
-    VkImageMemoryBarrier transformSwapchainBarrier{};
-    transformSwapchainBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    transformSwapchainBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    transformSwapchainBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    transformSwapchainBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    transformSwapchainBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-    transformSwapchainBarrier.image = dst;
-    transformSwapchainBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    transformSwapchainBarrier.subresourceRange.levelCount = 1;
-    transformSwapchainBarrier.subresourceRange.layerCount = 1;
-
-    vkCmdPipelineBarrier(
-        commandBuffer,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        0,
-        0,
-        nullptr,
-        0,
-        nullptr,
-        1,
-        &transformSwapchainBarrier
-    );
-
     VkImageCopy copyRegion{};
     copyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    copyRegion.srcSubresource.baseArrayLayer = srcLayer;
     copyRegion.srcSubresource.layerCount = 1;
     copyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     copyRegion.dstSubresource.layerCount = 1;
@@ -49,29 +47,188 @@ void Utils::ImageTransfer::CmdCopyToFB(
         1,
         &copyRegion
     );
+}
 
-    // transform FB to be presentable
-    VkImageMemoryBarrier presentBarrier{};
-    presentBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    presentBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    presentBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    presentBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    presentBarrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-    presentBarrier.image = dst;
-    presentBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    presentBarrier.subresourceRange.levelCount = 1;
-    presentBarrier.subresourceRange.layerCount = 1;
-
-    vkCmdPipelineBarrier(
-        commandBuffer,
-        VK_PIPELINE_STAGE_TRANSFER_BIT,
-        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-        0,
-        0,
-        nullptr,
-        0,
-        nullptr,
-        1,
-        &presentBarrier
-    );
+void Utils::Thread::SetCurrentThreadName(const char* name)
+{
+#if __linux__
+    pthread_setname_np(pthread_self(), name);
+#elif __APPLE__
+    pthread_setname_np(name);
+#endif
+}
+
+std::string Utils::Thread::GetCurrentThreadName()
+{
+    char name[64] = {};
+#if __linux__ || __APPLE__
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+#endif
+    return name;
+}
+
+uint32_t Utils::Thread::GetCurrentThreadId()
+{
+#if __linux__
+    return syscall(SYS_gettid);
+#elif __APPLE__
+    uint64_t id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return id;
+#else
+    return std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
+}
+
+bool Utils::Thread::SetCurrentThreadRealtime()
+{
+#if __linux__
+    // lowest real-time priority: still preempts every normal thread
+    sched_param param{.sched_priority = sched_get_priority_min(SCHED_FIFO)};
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+    return false;
+#endif // __linux__
+}
+
+bool Utils::Thread::SetCurrentThreadNice(int nice)
+{
+#if __linux__ // nice values are per thread on linux, identified by their tid
+    return setpriority(PRIO_PROCESS, syscall(SYS_gettid), nice) == 0;
+#else
+    return false;
+#endif // __linux__
+}
+
+bool Utils::Thread::SetCurrentThreadAffinity(int core)
+{
+#if __linux__
+    if (core < 0 || core >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(core, &cores);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores) == 0;
+#else
+    return false;
+#endif // __linux__
+}
+
+std::optional<Utils::Thread::Scheduling> Utils::Thread::GetCurrentThreadScheduling()
+{
+#if __linux__
+    Scheduling scheduling;
+    cpu_set_t cores;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cores), &cores) != 0) {
+        return std::nullopt;
+    }
+    for (int core = 0; core < CPU_SETSIZE; core++) {
+        if (CPU_ISSET(core, &cores)) {
+            scheduling.cores.push_back(core);
+        }
+    }
+    sched_param param;
+    if (pthread_getschedparam(pthread_self(), &scheduling.policy, &param) != 0) {
+        return std::nullopt;
+    }
+    scheduling.priority = param.sched_priority;
+    errno = 0; // -1 is a valid nice value
+    scheduling.nice = getpriority(PRIO_PROCESS, syscall(SYS_gettid));
+    if (errno != 0) {
+        return std::nullopt;
+    }
+    return scheduling;
+#else
+    return std::nullopt;
+#endif // __linux__
+}
+
+bool Utils::Thread::SetCurrentThreadScheduling(const Scheduling& scheduling)
+{
+#if __linux__
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    for (int core : scheduling.cores) {
+        CPU_SET(core, &cores);
+    }
+    bool pinned = pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores) == 0;
+    sched_param param{.sched_priority = scheduling.priority};
+    bool scheduled = pthread_setschedparam(pthread_self(), scheduling.policy, &param) == 0;
+    // leaving a real-time policy first, nice values only apply to normal ones
+    return SetCurrentThreadNice(scheduling.nice) && pinned && scheduled;
+#else
+    return false;
+#endif // __linux__
+}
+
+int Utils::Thread::GetNumCores() { return std::max(std::thread::hardware_concurrency(), 1u); }
+
+std::vector<int> Utils::Thread::GetIsolatedCores()
+{
+    std::vector<int> cores;
+#if __linux__
+    // a cpu list, e.g. "2,4-7"
+    std::ifstream file("/sys/devices/system/cpu/isolated");
+    std::string range;
+    while (std::getline(file, range, ',')) {
+        int first = 0;
+        int last = 0;
+        char dash = 0;
+        std::istringstream stream(range);
+        if (!(stream >> first)) {
+            continue; // empty when nothing is isolated
+        }
+        if (!(stream >> dash >> last)) { // a single core
+            last = first;
+        }
+        for (int core = first; core <= last; core++) {
+            cores.push_back(core);
+        }
+    }
+#endif // __linux__
+    return cores;
+}
+
+Utils::Thread::ContextSwitchCounter::ContextSwitchCounter()
+{
+#if __linux__
+    _fd = open("/proc/thread-self/status", O_RDONLY | O_CLOEXEC);
+#endif // __linux__
+}
+
+Utils::Thread::ContextSwitchCounter::~ContextSwitchCounter()
+{
+#if __linux__
+    if (_fd >= 0) {
+        close(_fd);
+    }
+#endif // __linux__
+}
+
+std::optional<Utils::Thread::ContextSwitches> Utils::Thread::ContextSwitchCounter::Read()
+{
+#if __linux__
+    if (_fd < 0) {
+        return std::nullopt;
+    }
+    // the kernel regenerates the file on every read from the start
+    char status[4096];
+    ssize_t size = pread(_fd, status, sizeof(status) - 1, 0);
+    if (size <= 0) {
+        return std::nullopt;
+    }
+    status[size] = '\0';
+    const char* voluntary = strstr(status, "\nvoluntary_ctxt_switches:");
+    const char* involuntary = strstr(status, "\nnonvoluntary_ctxt_switches:");
+    if (voluntary == nullptr || involuntary == nullptr) {
+        return std::nullopt;
+    }
+    return ContextSwitches{
+        .voluntary = strtoull(strchr(voluntary, ':') + 1, nullptr, 10),
+        .involuntary = strtoull(strchr(involuntary, ':') + 1, nullptr, 10)
+    };
+#else
+    return std::nullopt;
+#endif // __linux__
 }
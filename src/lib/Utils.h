@@ -1,17 +1,85 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
 // generate utils
 
 namespace Utils
 {
 namespace ImageTransfer
 {
-// record the command that transfers content from one frame buffer image to another
-// both SRC and DST needs to be image associated with a frame buffer, and should have the same extent.
+// record the copy of layer SRCLAYER of SRC onto DST; both have the same EXTENT.
 // SRC should be in layout VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
-// DST should be in layout  VK_IMAGE_LAYOUT_UNDEFINED -- default layout of physically created frame buffer image
-void CmdCopyToFB(VkCommandBuffer commandBuffer, VkImage& src, VkImage& dst, VkExtent2D extent);
+// DST should be in layout VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
+// Synchronization is left to the caller, see `FrameGraph`.
+void CmdCopyImage(
+    VkCommandBuffer commandBuffer,
+    VkImage src,
+    VkImage dst,
+    VkExtent2D extent,
+    uint32_t srcLayer = 0
+);
 
 } // namespace ImageTransfer
 
+namespace Thread
+{
+// name the calling thread, as shown by debuggers and `top -H`; at most 15 characters on linux
+void SetCurrentThreadName(const char* name);
+// the name set above, empty if unnamed or unsupported
+std::string GetCurrentThreadName();
+// the OS's id of the calling thread, e.g. its tid on linux, as shown by `top -H`
+uint32_t GetCurrentThreadId();
+
+// move the calling thread into a real-time scheduling class so that it wakes up right away,
+// false if not permitted, e.g. without CAP_SYS_NICE or a matching rtprio limit
+bool SetCurrentThreadRealtime();
+// raise the calling thread's priority to nice value NICE within the normal scheduling class,
+// false if not permitted; for where real-time scheduling isn't
+bool SetCurrentThreadNice(int nice);
+// pin the calling thread to CORE, false if not permitted or no such core
+bool SetCurrentThreadAffinity(int core);
+int GetNumCores();
+// cores kept free of other threads by the kernel, e.g. by `isolcpus=`; empty if unknown
+std::vector<int> GetIsolatedCores();
+
+// what the calls above change, as the calling thread had it; e.g. as narrowed by `taskset`
+struct Scheduling
+{
+    std::vector<int> cores; // allowed to run on
+    int policy = 0;         // e.g. SCHED_OTHER
+    int priority = 0;       // within POLICY
+    int nice = 0;
+};
+
+std::optional<Scheduling> GetCurrentThreadScheduling(); // `std::nullopt` if unsupported
+// e.g. back to what `GetCurrentThreadScheduling()` returned, false if any of it failed
+bool SetCurrentThreadScheduling(const Scheduling& scheduling);
+
+struct ContextSwitches
+{
+    uint64_t voluntary = 0;   // the thread blocked, e.g. on a fence or a sleep
+    uint64_t involuntary = 0; // the scheduler preempted it
+};
+
+// reads the context switches of the thread that constructed it from /proc, e.g. once a frame;
+// the file stays open in between so that re-reads are cheap
+class ContextSwitchCounter
+{
+  public:
+    ContextSwitchCounter();
+    ~ContextSwitchCounter();
+    ContextSwitchCounter(const ContextSwitchCounter&) = delete;
+    ContextSwitchCounter& operator=(const ContextSwitchCounter&) = delete;
+
+    std::optional<ContextSwitches> Read(); // `std::nullopt` where /proc is unavailable
+
+  private:
+    int _fd = -1;
+};
+} // namespace Thread
+
 } // namespace Utils
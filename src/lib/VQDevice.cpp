@@ -1,11 +1,24 @@
 #include "VQDevice.h"
 #include "VQBuffer.h"
 #include "VQUtils.h"
+#include <algorithm>
 #include <cstdint>
 #include <set>
 #include <vulkan/vulkan_core.h>
 
-void VQDevice::CreateLogicalDeviceAndQueue(const std::vector<const char*>& extensions) {
+void VQDevice::CreateLogicalDeviceAndQueue(
+    const std::vector<const char*>& requiredExtensions,
+    const std::vector<const char*>& optionalExtensions
+) {
+    std::vector<const char*> extensions = requiredExtensions;
+    for (const char* extension : optionalExtensions) {
+        if (std::find(supportedExtensions.begin(), supportedExtensions.end(), extension)
+            != supportedExtensions.end()) {
+            extensions.push_back(extension);
+        } else {
+            INFO("optional extension {} not supported", extension);
+        }
+    }
     if (!this->queueFamilyIndices.isComplete()) {
         FATAL("Queue family indices incomplete! Call InitQueueFamilyIndices().");
     }
@@ -33,6 +46,35 @@ void VQDevice::CreateLogicalDeviceAndQueue(const std::vector<const char*>& exten
     vk::PhysicalDeviceVulkan12Features deviceFeaturesVk12;
     deviceFeaturesVk12.timelineSemaphore = true;
 
+    // features that come with optional extensions;
+    // an extension being supported implies its core feature is
+    vk::PhysicalDeviceMultiviewFeatures multiviewFeatures;
+    multiviewFeatures.multiview = true;
+    vk::PhysicalDeviceSynchronization2FeaturesKHR synchronization2Features;
+    synchronization2Features.synchronization2 = true;
+    vk::PhysicalDevicePresentIdFeaturesKHR presentIdFeatures;
+    presentIdFeatures.presentId = true;
+    vk::PhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures;
+    presentWaitFeatures.presentWait = true;
+    std::unordered_set<std::string> extensionsEnabled(extensions.begin(), extensions.end());
+    void** featuresTail = &deviceFeaturesVk12.pNext; // append enabled features to the chain
+    if (extensionsEnabled.contains(VK_KHR_MULTIVIEW_EXTENSION_NAME)) {
+        *featuresTail = &multiviewFeatures;
+        featuresTail = &multiviewFeatures.pNext;
+    }
+    if (extensionsEnabled.contains(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME)) {
+        *featuresTail = &synchronization2Features;
+        featuresTail = &synchronization2Features.pNext;
+    }
+    if (extensionsEnabled.contains(VK_KHR_PRESENT_ID_EXTENSION_NAME)) {
+        *featuresTail = &presentIdFeatures;
+        featuresTail = &presentIdFeatures.pNext;
+    }
+    if (extensionsEnabled.contains(VK_KHR_PRESENT_WAIT_EXTENSION_NAME)) {
+        *featuresTail = &presentWaitFeatures;
+        featuresTail = &presentWaitFeatures.pNext;
+    }
+
     VkDeviceCreateInfo createInfo{};
     float queuePriority = 1.f;
     for (uint32_t queueFamily : uniqueQueueFamilyIndices) {
@@ -52,6 +94,7 @@ void VQDevice::CreateLogicalDeviceAndQueue(const std::vector<const char*>& exten
     createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
     createInfo.ppEnabledExtensionNames = extensions.data(); // enable swapchain extension
     VK_CHECK_RESULT(vkCreateDevice(this->physicalDevice, &createInfo, nullptr, &this->logicalDevice));
+    enabledExtensions = std::move(extensionsEnabled);
     vkGetDeviceQueue(this->logicalDevice, queueFamilyIndices.graphicsFamily.value(), 0, &this->graphicsQueue);
     vkGetDeviceQueue(this->logicalDevice, queueFamilyIndices.presentationFamily.value(), 0, &this->presentationQueue);
     vkGetDeviceQueue(this->logicalDevice, queueFamilyIndices.computeFamily.value(), 0, &this->computeQueue);
@@ -74,7 +117,11 @@ void VQDevice::InitQueueFamilyIndices(VkSurfaceKHR surface) {
             this->queueFamilyIndices.graphicsFamily = i;
             DEBUG("Graphics family found at {}", i);
         }
-        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentationSupport);
+        if (surface == VK_NULL_HANDLE) { // headless, "present" on the graphics queue
+            presentationSupport = (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+        } else {
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentationSupport);
+        }
         if (presentationSupport) {
             this->queueFamilyIndices.presentationFamily = i;
             DEBUG("Presentation family found at {}", i);
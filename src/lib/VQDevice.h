@@ -3,6 +3,7 @@
 #include "vulkan/vulkan.h"
 #include "vulkan/vulkan.hpp"
 #include <optional>
+#include <unordered_set>
 #include <vulkan/vulkan_core.h>
 
 struct VQBuffer;
@@ -53,6 +54,8 @@ struct VQDevice
     std::vector<VkQueueFamilyProperties> queueFamilyProperties;
     /** @brief List of extensions supported by the device */
     std::vector<std::string> supportedExtensions;
+    /** @brief Extensions enabled on the logical device, including supported optional ones */
+    std::unordered_set<std::string> enabledExtensions;
     /** @brief Graphics command buffer associated with this device.*/
     std::vector<VkCommandBuffer> graphicsCommandBuffers;
     /** @brief Graphics command buffer2 associated with this device.*/
@@ -83,6 +86,7 @@ struct VQDevice
      * presentation.
      *
      * @param surface The surface on which the presentation queue will present to.
+     * VK_NULL_HANDLE for headless devices, whose presentation queue is the graphics queue.
      */
     void InitQueueFamilyIndices(VkSurfaceKHR surface);
 
@@ -90,8 +94,18 @@ struct VQDevice
      * @brief Create a Logical Device, and create a graphics queue and a presentation queue.
      *
      * @param extensions the extensions to enable
+     * @param optionalExtensions extensions to enable only if the device supports them,
+     * check with IsExtensionEnabled()
      */
-    void CreateLogicalDeviceAndQueue(const std::vector<const char*>& extensions);
+    void CreateLogicalDeviceAndQueue(
+        const std::vector<const char*>& extensions,
+        const std::vector<const char*>& optionalExtensions = {}
+    );
+
+    bool IsExtensionEnabled(const char* extension) const
+    {
+        return enabledExtensions.contains(extension);
+    }
 
     /**
      * @brief Create a Graphics Command Pool, the pool is used for allocating command buffers.
@@ -1,4 +1,6 @@
+#include <cctype>
 #include <iostream>
+#include <string>
 
 #include "Tetrium.h"
 
@@ -22,6 +24,38 @@ int main(int argc, char** argv)
     Tetrium::InitOptions options{
         .tetraMode = Tetrium::TetraMode::kEvenOddHardwareSync
     };
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--separate-imgui-pass") {
+            options.mergeImGuiPass = false;
+        } else if (arg == "--no-render-thread") {
+            options.renderThread = false;
+        } else if (arg == "--multiview") {
+            options.multiview = true;
+        } else if (arg == "--frame-pacing") {
+            options.framePacing = true;
+        } else if (arg == "--headless") { // --headless [ticks]
+            options.tetraMode = Tetrium::TetraMode::kHeadless;
+            if (i + 1 < argc && std::isdigit(argv[i + 1][0])) {
+                options.headlessTicks = std::stoull(argv[++i]);
+            }
+        } else if (arg == "--realtime-present") { // --realtime-present [core]
+            options.realtimePresentThread = true;
+            if (i + 1 < argc && std::isdigit(argv[i + 1][0])) {
+                options.presentThreadCore = std::stoi(argv[++i]);
+            }
+        } else if (arg == "--soak") { // --soak [seconds per load level]
+            options.soakSecondsPerLevel = 60;
+            if (i + 1 < argc && std::isdigit(argv[i + 1][0])) {
+                options.soakSecondsPerLevel = std::stod(argv[++i]);
+            }
+        } else if (arg == "--virtual-display") { // --virtual-display [refresh rate hz]
+            options.tetraMode = Tetrium::TetraMode::kEvenOddVirtualSync;
+            if (i + 1 < argc && std::isdigit(argv[i + 1][0])) {
+                options.virtualDisplay.refreshRateHz = std::stod(argv[++i]);
+            }
+        }
+    }
     Tetrium engine;
     engine.Init(options);
     engine.Run();
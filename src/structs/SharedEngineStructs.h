@@ -27,6 +27,7 @@ struct TickContext
     double deltaTime;
     GraphicsContext graphics;
     Profiler* profiler;
+    uint32_t extraDrawInstances = 0; // synthetic GPU load, see `LoadGenerator`
 };
 
 class VQDevice;
@@ -39,12 +40,15 @@ struct InitContext
     TextureManager* textureManager;
 
     VkRenderPass renderPasses[ColorSpace::ColorSpaceSize];
+    // renders all color spaces at once, VK_NULL_HANDLE if multiview is unsupported
+    VkRenderPass multiviewRenderPass = VK_NULL_HANDLE;
 
     // temporary
     // TODO: clean up
     const char* VERTEX_SHADER_SRC = "../shaders/phong/phong.vert.spv";
     const char* FRAGMENT_SHADER_RGB_SRC = "../shaders/phong/phong_rgb.frag.spv";
     const char* FRAGMENT_SHADER_OCV_SRC = "../shaders/phong/phong_cmy.frag.spv";
+    const char* FRAGMENT_SHADER_MULTIVIEW_SRC = "../shaders/phong/phong_multiview.frag.spv";
 
     /**
      * points to initialized buffer of static engine ubo
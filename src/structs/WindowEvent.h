@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+struct GLFWmonitor;
+
+// A glfw callback invocation, recorded on the thread polling window events
+// to be replayed on the render thread.
+struct WindowEvent
+{
+    enum class Type : uint8_t
+    {
+        kWindowFocus, // i[0]: focused
+        kCursorEnter, // i[0]: entered
+        kCursorPos,   // d[0], d[1]: x, y
+        kMouseButton, // i[0..2]: button, action, mods
+        kScroll,      // d[0], d[1]: x, y offset
+        kKey,         // i[0..3]: key, scancode, action, mods
+        kChar,        // i[0]: codepoint
+        kMonitor      // monitor, i[0]: event
+    };
+
+    Type type;
+    int i[4] = {};
+    double d[2] = {};
+    GLFWmonitor* monitor = nullptr;
+    // kMouseButton & kKey: what imgui's glfw backend would query glfw for, which only the
+    // polling thread may do; the modifiers held (GLFW_MOD_*) and the key as laid out
+    int heldMods = 0;
+    int translatedKey = 0;
+};